@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <unordered_map>
 #ifndef FC_DEBUG
 #include <random>
@@ -1075,8 +1076,8 @@ void ElementMap::collectChildMaps(std::map<const ElementMap*, int>& childMapSet,
         }
     }
 
-    for (auto& mappedName : this->mappedNames) {
-        addPostfix(mappedName.first.constPostfix(), postfixMap, postfixes);
+    for (auto* mappedName : sortedMappedNames()) {
+        addPostfix(mappedName->first.constPostfix(), postfixMap, postfixes);
     }
 
     childMaps.push_back(this);
@@ -1298,12 +1299,25 @@ std::vector<ElementMap::MappedChildElements> ElementMap::getChildElements() cons
     return res;
 }
 
+std::vector<const ElementMap::MappedNameEntry*> ElementMap::sortedMappedNames() const
+{
+    std::vector<const MappedNameEntry*> res;
+    res.reserve(this->mappedNames.size());
+    for (auto& mappedName : this->mappedNames) {
+        res.push_back(&mappedName);
+    }
+    std::sort(res.begin(), res.end(), [](const MappedNameEntry* a, const MappedNameEntry* b) {
+        return a->first < b->first;
+    });
+    return res;
+}
+
 std::vector<MappedElement> ElementMap::getAll() const
 {
     std::vector<MappedElement> ret;
     ret.reserve(size());
-    for (auto& mappedName : this->mappedNames) {
-        ret.emplace_back(mappedName.first, mappedName.second);
+    for (auto* mappedName : sortedMappedNames()) {
+        ret.emplace_back(mappedName->first, mappedName->second);
     }
     for (auto& childElement : this->childElements) {
         auto& child = *childElement.childMap;
@@ -37,6 +37,8 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 
 namespace Data
@@ -66,7 +68,9 @@ typedef std::function<bool(const MappedName&, int, long, long)> TraceCallback;
  * `indexedNames` maps a string to both a name queue and children.
  *   each of those children store an IndexedName, offset details, postfix, ids, and
  *   possibly a recursive elementmap
- * `mappedNames` maps a MappedName to a specific IndexedName.
+ * `mappedNames` maps a MappedName to a specific IndexedName. It is a hash table, since lookup
+ *   by name is the hot path when generating and querying large maps. Use sortedMappedNames()
+ *   wherever a stable iteration order is required (e.g. saving).
  */
 class AppExport ElementMap
     : public std::enable_shared_from_this<ElementMap>  // TODO can remove shared_from_this?
@@ -303,7 +307,30 @@ private:
 
     std::map<const char*, IndexedElements, CStringComp> indexedNames;
 
-    std::map<MappedName, IndexedName, std::less<>> mappedNames;
+    /// Hashes the concatenation of data and postfix, consistent with MappedName::operator==()
+    struct MappedNameHash
+    {
+        std::size_t operator()(const MappedName& name) const
+        {
+            // FNV-1a
+            std::size_t res = 2166136261U;
+            auto hashBytes = [&res](const QByteArray& bytes) {
+                for (char c : bytes) {
+                    res = (res ^ static_cast<unsigned char>(c)) * 16777619U;
+                }
+            };
+            hashBytes(name.dataBytes());
+            hashBytes(name.postfixBytes());
+            return res;
+        }
+    };
+
+    std::unordered_map<MappedName, IndexedName, MappedNameHash> mappedNames;
+
+    using MappedNameEntry = std::pair<const MappedName, IndexedName>;
+
+    /// Returns the entries of \c mappedNames ordered by name
+    std::vector<const MappedNameEntry*> sortedMappedNames() const;
 
     struct ChildMapInfo
     {
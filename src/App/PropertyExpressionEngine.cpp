@@ -91,6 +91,17 @@ struct PropertyExpressionEngine::Private
     // defined in header, hence the private structure here.
     std::vector<boost::signals2::scoped_connection> conns;
     std::unordered_map<std::string, std::vector<ObjectIdentifier>> propMap;
+
+    // Change tracking used by execute() to only evaluate bindings whose input changed. The map
+    // is keyed by the full name of a dependent property, or of a dependent object for whole
+    // object references. If any reference can not be resolved to a property, changes can not be
+    // tracked and every binding is evaluated. Frozen objects do not report their changes either.
+    std::vector<boost::signals2::scoped_connection> depConns;
+    std::unordered_map<std::string, std::vector<ObjectIdentifier>> depMap;
+    std::set<const App::DocumentObject*> depObjs;
+    std::set<ObjectIdentifier> dirty;
+    bool tracking = false;
+    bool unresolved = false;
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -143,6 +154,8 @@ Property* PropertyExpressionEngine::Copy() const
 
 void PropertyExpressionEngine::hasSetValue()
 {
+    resetExecuteCache();
+
     App::DocumentObject* owner = dynamic_cast<App::DocumentObject*>(getContainer());
     if (!owner || !owner->isAttachedToDocument() || owner->isRestoring()
         || testFlag(LinkDetached)) {
@@ -227,6 +240,116 @@ void PropertyExpressionEngine::hasSetValue()
     PropertyExpressionContainer::hasSetValue();
 }
 
+void PropertyExpressionEngine::resetExecuteCache()
+{
+    evaluationOrders.clear();
+    if (pimpl) {
+        pimpl->depConns.clear();
+        pimpl->depMap.clear();
+        pimpl->depObjs.clear();
+        pimpl->dirty.clear();
+        pimpl->tracking = false;
+        pimpl->unresolved = false;
+    }
+}
+
+void PropertyExpressionEngine::trackDependencies()
+{
+    if (!pimpl) {
+        pimpl = std::make_unique<Private>();
+    }
+    pimpl->depConns.clear();
+    pimpl->depMap.clear();
+    pimpl->depObjs.clear();
+    pimpl->unresolved = false;
+    // Deleted objects and documents do not signal a change, so watch for them separately
+    // NOLINTBEGIN
+    pimpl->depConns.emplace_back(GetApplication().signalDeletedObject.connect(
+        std::bind(&PropertyExpressionEngine::slotDeletedDependency, this, sp::_1)));
+    pimpl->depConns.emplace_back(GetApplication().signalDeleteDocument.connect(
+        std::bind(&PropertyExpressionEngine::slotDeletedDocument, this, sp::_1)));
+    // NOLINTEND
+    for (auto& e : expressions) {
+        pimpl->dirty.insert(e.first);
+        // Changing the bound property directly must restore the expression value
+        if (auto prop = e.first.getProperty()) {
+            pimpl->depMap[prop->getFullName()].push_back(e.first);
+        }
+        if (!e.second.expression) {
+            continue;
+        }
+        // References to missing objects or properties, and pseudo properties such as _app or
+        // _self, do not report their changes
+        for (auto& v : e.second.expression->getIdentifiers()) {
+            int ptype = 0;
+            if (!v.first.getProperty(&ptype) || ptype != 0) {
+                pimpl->unresolved = true;
+            }
+        }
+        for (auto& dep : e.second.expression->getDeps(Expression::DepAll)) {
+            auto obj = dep.first;
+            if (!obj || !obj->isAttachedToDocument()) {
+                continue;
+            }
+            if (pimpl->depObjs.insert(obj).second) {
+                // NOLINTBEGIN
+                pimpl->depConns.emplace_back(obj->signalChanged.connect(
+                    std::bind(&PropertyExpressionEngine::slotChangedDependency,
+                              this,
+                              sp::_1,
+                              sp::_2)));
+                // NOLINTEND
+            }
+            auto objName = obj->getFullName();
+            for (auto& propDep : dep.second) {
+                const auto& propName = propDep.first;
+                pimpl->depMap[propName.empty() ? objName : objName + "." + propName].push_back(
+                    e.first);
+            }
+        }
+    }
+    // Keep collecting on every execute() until all references resolve
+    pimpl->tracking = !pimpl->unresolved;
+}
+
+void PropertyExpressionEngine::slotChangedDependency(const App::DocumentObject& obj,
+                                                     const App::Property& prop)
+{
+    // A changed link may redirect references to other objects, so collect the dependencies
+    // again. The connections are only dropped in the next execute(), not while signalling.
+    // The same goes for a changed label, which label references are renamed to.
+    if (prop.isDerivedFrom<PropertyLinkBase>() || &prop == &obj.Label) {
+        pimpl->tracking = false;
+        return;
+    }
+    for (const auto& key : {prop.getFullName(), obj.getFullName()}) {
+        auto it = pimpl->depMap.find(key);
+        if (it != pimpl->depMap.end()) {
+            pimpl->dirty.insert(it->second.begin(), it->second.end());
+        }
+    }
+}
+
+void PropertyExpressionEngine::slotDeletedDependency(const App::DocumentObject& obj)
+{
+    // Collecting the dependencies again marks every binding for evaluation
+    if (pimpl->depObjs.count(&obj) != 0) {
+        pimpl->tracking = false;
+        pimpl->depObjs.clear();
+    }
+}
+
+void PropertyExpressionEngine::slotDeletedDocument(const App::Document& doc)
+{
+    for (auto obj : pimpl->depObjs) {
+        if (obj->getDocument() == &doc) {
+            pimpl->tracking = false;
+            pimpl->depObjs.clear();
+            break;
+        }
+    }
+}
+
 void PropertyExpressionEngine::updateHiddenReference(const std::string& key)
 {
     if (!pimpl) {
@@ -482,6 +605,7 @@ void PropertyExpressionEngine::afterRestore()
 
 void PropertyExpressionEngine::onContainerRestored()
 {
+    resetExecuteCache();
     Base::FlagToggler<bool> flag(restoring);
     unregisterElementReference();
     UpdateElementReferenceExpressionVisitor<PropertyExpressionEngine> v(*this);
@@ -580,6 +704,37 @@ protected:
     int& _src;
 };
 
+/**
+ * @brief Check whether the binding of \a path is evaluated with \a option.
+ *
+ * This depends on the Output, Transient and EvalOnRestore status of the bound property.
+ *
+ * @param path Bound property.
+ * @param option Execute option.
+ * @return True if the binding is evaluated.
+ */
+
+bool PropertyExpressionEngine::isSelected(const App::ObjectIdentifier& path, ExecuteOption option)
+{
+    if (option == ExecuteAll) {
+        return true;
+    }
+    auto prop = path.getProperty();
+    if (!prop) {
+        throw Base::RuntimeError("Path does not resolve to a property.");
+    }
+    bool is_output =
+        prop->testStatus(App::Property::Output) || (prop->getType() & App::Prop_Output);
+    if ((is_output && option == ExecuteNonOutput) || (!is_output && option == ExecuteOutput)) {
+        return false;
+    }
+    if (option == ExecuteOnRestore && !prop->testStatus(Property::Transient)
+        && !(prop->getType() & Prop_Transient) && !prop->testStatus(Property::EvalOnRestore)) {
+        return false;
+    }
+    return true;
+}
+
 /**
  * @brief Build a graph of all expressions in \a exprs.
  * @param exprs Expressions to use in graph
@@ -598,22 +753,8 @@ void PropertyExpressionEngine::buildGraph(const ExpressionMap& exprs,
 
     // Build data structure for graph
     for (const auto& expr : exprs) {
-        if (option != ExecuteAll) {
-            auto prop = expr.first.getProperty();
-            if (!prop) {
-                throw Base::RuntimeError("Path does not resolve to a property.");
-            }
-            bool is_output =
-                prop->testStatus(App::Property::Output) || (prop->getType() & App::Prop_Output);
-            if ((is_output && option == ExecuteNonOutput)
-                || (!is_output && option == ExecuteOutput)) {
-                continue;
-            }
-            if (option == ExecuteOnRestore && !prop->testStatus(Property::Transient)
-                && !(prop->getType() & Prop_Transient)
-                && !prop->testStatus(Property::EvalOnRestore)) {
-                continue;
-            }
+        if (!isSelected(expr.first, option)) {
+            continue;
         }
         buildGraphStructures(expr.first, expr.second.expression, nodes, revNodes, edges);
     }
@@ -643,11 +784,26 @@ void PropertyExpressionEngine::buildGraph(const ExpressionMap& exprs,
  * The code below builds a graph for all expressions in the engine, and
  * finds any circular dependencies. It also computes the internal evaluation
  * order, in case properties depends on each other.
+ *
+ * The result is cached per execute option until the expressions change.
  */
 
-std::vector<App::ObjectIdentifier>
+const std::vector<App::ObjectIdentifier>&
 PropertyExpressionEngine::computeEvaluationOrder(ExecuteOption option)
 {
+    // The selected bindings depend on the status of the bound properties, which may change
+    // without changing the expressions
+    std::vector<bool> selected;
+    selected.reserve(expressions.size());
+    for (const auto& expr : expressions) {
+        selected.push_back(isSelected(expr.first, option));
+    }
+
+    auto cached = evaluationOrders.find(option);
+    if (cached != evaluationOrders.end() && cached->second.selected == selected) {
+        return cached->second.order;
+    }
+
     std::vector<App::ObjectIdentifier> evaluationOrder;
     boost::unordered_map<int, ObjectIdentifier> revNodes;
     DiGraph g;
@@ -666,7 +822,10 @@ PropertyExpressionEngine::computeEvaluationOrder(ExecuteOption option)
         }
     }
 
-    return evaluationOrder;
+    auto& entry = evaluationOrders[option];
+    entry.selected = std::move(selected);
+    entry.order = std::move(evaluationOrder);
+    return entry.order;
 }
 
 /**
@@ -729,7 +888,26 @@ DocumentObjectExecReturn* App::PropertyExpressionEngine::execute(ExecuteOption o
 
     resetter r(running);
 
+    // Evaluate only the bindings whose dependencies changed since they were last evaluated,
+    // except on restore or with unresolved references where every binding is evaluated.
+    bool skipUnchanged = option != ExecuteOnRestore;
+    if (skipUnchanged) {
+        if (!pimpl || !pimpl->tracking) {
+            trackDependencies();
+        }
+        skipUnchanged = !pimpl->unresolved;
+        for (auto obj : pimpl->depObjs) {
+            if (obj->isFreezed()) {
+                // Evaluate everything again once the object is thawed
+                skipUnchanged = false;
+                pimpl->tracking = false;
+                break;
+            }
+        }
+    }
+
     // Compute evaluation order
+    // Copy, since evaluating may change the expressions and hence invalidate the cached order
     std::vector<App::ObjectIdentifier> evaluationOrder = computeEvaluationOrder(option);
     std::vector<ObjectIdentifier>::const_iterator it = evaluationOrder.begin();
 
@@ -740,6 +918,10 @@ DocumentObjectExecReturn* App::PropertyExpressionEngine::execute(ExecuteOption o
     /* Evaluate the expressions, and update properties */
     for (; it != evaluationOrder.end(); ++it) {
 
+        if (skipUnchanged && pimpl->dirty.count(*it) == 0) {
+            continue;
+        }
+
         // Get property to update
         Property* prop = it->getProperty();
 
@@ -776,6 +958,9 @@ DocumentObjectExecReturn* App::PropertyExpressionEngine::execute(ExecuteOption o
                 // if (option == ExecuteOnRestore && prop->testStatus(Property::EvalOnRestore))
                 {
                     if (isAnyEqual(value, prop->getPathValue(*it))) {
+                        if (pimpl) {
+                            pimpl->dirty.erase(*it);
+                        }
                         continue;
                     }
                     if (touched) {
@@ -784,6 +969,10 @@ DocumentObjectExecReturn* App::PropertyExpressionEngine::execute(ExecuteOption o
                 }
                 prop->setPathValue(*it, value);
             }
+            // Erase after setting the value, since that marks this binding as changed
+            if (pimpl) {
+                pimpl->dirty.erase(*it);
+            }
         }
         catch (Base::Exception& e) {
             std::ostringstream ss;
@@ -1208,6 +1397,9 @@ void PropertyExpressionEngine::setExpressions(
 
 void PropertyExpressionEngine::onRelabeledDocument(const App::Document& doc)
 {
+    if (pimpl) {
+        pimpl->tracking = false;
+    }
     RelabelDocumentExpressionVisitor v(doc);
     for (auto& e : expressions) {
         if (e.second.expression) {
@@ -209,7 +209,7 @@ private:
     using ExpressionMap = std::map<const App::ObjectIdentifier, ExpressionInfo>;
 #endif
 
-    std::vector<App::ObjectIdentifier> computeEvaluationOrder(ExecuteOption option);
+    const std::vector<App::ObjectIdentifier>& computeEvaluationOrder(ExecuteOption option);
 
     void buildGraphStructures(const App::ObjectIdentifier& path,
                               const std::shared_ptr<Expression> expression,
@@ -217,6 +217,8 @@ private:
                               boost::unordered_map<int, App::ObjectIdentifier>& revNodes,
                               std::vector<Edge>& edges) const;
 
+    static bool isSelected(const App::ObjectIdentifier& path, ExecuteOption option);
+
     void buildGraph(const ExpressionMap& exprs,
                     boost::unordered_map<int, App::ObjectIdentifier>& revNodes,
                     DiGraph& g,
@@ -224,6 +226,11 @@ private:
 
     void slotChangedObject(const App::DocumentObject& obj, const App::Property& prop);
     void slotChangedProperty(const App::DocumentObject& obj, const App::Property& prop);
+    void slotChangedDependency(const App::DocumentObject& obj, const App::Property& prop);
+    void slotDeletedDependency(const App::DocumentObject& obj);
+    void slotDeletedDocument(const App::Document& doc);
+    void trackDependencies();
+    void resetExecuteCache();
     void updateHiddenReference(const std::string& key);
 
     bool running = false; /**< Boolean used to avoid loops */
@@ -231,6 +238,15 @@ private:
 
     ExpressionMap expressions; /**< Stored expressions */
 
+    struct EvaluationOrder
+    {
+        std::vector<bool> selected;
+        std::vector<App::ObjectIdentifier> order;
+    };
+    /**< Evaluation order computed by computeEvaluationOrder() for each execute option. It is
+     * reused until the stored expressions, or the bindings selected by the option, change. */
+    std::map<ExecuteOption, EvaluationOrder> evaluationOrders;
+
     ValidatorFunc validator; /**< Valdiator functor */
 
     struct RestoredExpression
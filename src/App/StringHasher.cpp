@@ -24,6 +24,7 @@
 #include <QCryptographicHash>
 #include <QHash>
 #include <deque>
+#include <mutex>
 
 #include <Base/Console.h>
 #include <Base/Reader.h>
@@ -82,8 +83,26 @@ class StringHasher::HashMap: public HashMapBase
 public:
     bool SaveAll = false;
     int Threshold = 0;
+    /// Guards the table. Recursive because getID() may recurse to encode postfix and
+    /// prefix, and dropping the last reference to a StringID erases its own entry.
+    std::recursive_mutex Mutex;
+
+    /// Reference to an entry found in the table. The table holds a reference to each entry and
+    /// only drops it with the mutex held, so an entry found with the mutex held and a non-zero
+    /// count cannot reach zero concurrently. An entry whose count already reached zero is being
+    /// deleted, it is removed from the table and an empty reference is returned.
+    StringIDRef tryRef(StringID* sid, int index = 0)
+    {
+        if (sid->getRefCount() <= 0) {
+            right.erase(sid->value());
+            return {};
+        }
+        return {sid, index};
+    }
 };
 
+using HasherLock = std::lock_guard<std::recursive_mutex>;
+
 ///////////////////////////////////////////////////////////
 
 TYPESYSTEM_SOURCE_ABSTRACT(App::StringID, Base::BaseClass)
@@ -91,7 +110,12 @@ TYPESYSTEM_SOURCE_ABSTRACT(App::StringID, Base::BaseClass)
 StringID::~StringID()
 {
     if (_hasher) {
-        _hasher->_hashes->right.erase(_id);
+        HasherLock lock(_hasher->_hashes->Mutex);
+        // the entry may already be replaced, see HashMap::tryRef()
+        auto it = _hasher->_hashes->right.find(_id);
+        if (it != _hasher->_hashes->right.end() && it->second == this) {
+            _hasher->_hashes->right.erase(it);
+        }
     }
 }
 
@@ -182,6 +206,7 @@ StringHasher::~StringHasher()
 
 void StringHasher::setSaveAll(bool enable)
 {
+    HasherLock lock(_hashes->Mutex);
     if (_hashes->SaveAll == enable) {
         return;
     }
@@ -191,6 +216,7 @@ void StringHasher::setSaveAll(bool enable)
 
 void StringHasher::compact()
 {
+    HasherLock lock(_hashes->Mutex);
     if (_hashes->SaveAll) {
         return;
     }
@@ -265,6 +291,7 @@ StringIDRef StringHasher::getID(const QByteArray& data, Options options)
     bool hashable = options.testFlag(Option::Hashable);
     bool nocopy = options.testFlag(Option::NoCopy);
 
+    HasherLock lock(_hashes->Mutex);
     bool hashed = hashable && _hashes->Threshold > 0 && (int)data.size() > _hashes->Threshold;
 
     StringID dataID;
@@ -279,7 +306,9 @@ StringIDRef StringHasher::getID(const QByteArray& data, Options options)
 
     auto it = _hashes->left.find(&dataID);
     if (it != _hashes->left.end()) {
-        return {it->first};
+        if (StringIDRef res = _hashes->tryRef(it->first)) {
+            return res;
+        }
     }
 
     if (!hashed && !nocopy) {
@@ -298,8 +327,32 @@ StringIDRef StringHasher::getID(const QByteArray& data, Options options)
     return {insert(sid)};
 }
 
+std::vector<StringIDRef> StringHasher::getIDs(const std::vector<QByteArray>& data,
+                                             Options options)
+{
+    std::vector<StringIDRef> res;
+    res.reserve(data.size());
+    HasherLock lock(_hashes->Mutex);
+    for (const auto& bytes : data) {
+        res.push_back(getID(bytes, options));
+    }
+    return res;
+}
+
+std::vector<StringIDRef> StringHasher::getIDs(const std::vector<Data::MappedName>& names)
+{
+    std::vector<StringIDRef> res;
+    res.reserve(names.size());
+    HasherLock lock(_hashes->Mutex);
+    for (const auto& name : names) {
+        res.push_back(getID(name, QVector<StringIDRef>()));
+    }
+    return res;
+}
+
 StringIDRef StringHasher::getID(const Data::MappedName& name, const QVector<StringIDRef>& sids)
 {
+    HasherLock lock(_hashes->Mutex);
     StringID tempID;
     tempID._postfix = name.postfixBytes();
 
@@ -323,11 +376,12 @@ StringIDRef StringHasher::getID(const Data::MappedName& name, const QVector<Stri
     // Check to see if there is already an entry in the hash table for this StringID
     auto it = _hashes->left.find(&tempID);
     if (it != _hashes->left.end()) {
-        auto res = StringIDRef(it->first);
-        if (indexed) {
-            res._index = indexed.getIndex();
+        if (StringIDRef res = _hashes->tryRef(it->first)) {
+            if (indexed) {
+                res._index = indexed.getIndex();
+            }
+            return res;
         }
-        return res;
     }
 
     if (!indexed && name.isRaw()) {
@@ -437,13 +491,12 @@ StringIDRef StringHasher::getID(long id, int index) const
     if (id <= 0) {
         return {};
     }
+    HasherLock lock(_hashes->Mutex);
     auto it = _hashes->right.find(id);
     if (it == _hashes->right.end()) {
         return {};
     }
-    StringIDRef res(it->second);
-    res._index = index;
-    return res;
+    return _hashes->tryRef(it->second, index);
 }
 
 void StringHasher::setPersistenceFileName(const char* filename) const
@@ -461,6 +514,7 @@ const std::string& StringHasher::getPersistenceFileName() const
 
 void StringHasher::Save(Base::Writer& writer) const
 {
+    HasherLock lock(_hashes->Mutex);
 
     std::size_t count = _hashes->SaveAll ? _hashes->size() : this->count();
 
@@ -489,6 +543,7 @@ void StringHasher::Save(Base::Writer& writer) const
 
 void StringHasher::SaveDocFile(Base::Writer& writer) const
 {
+    HasherLock lock(_hashes->Mutex);
     std::size_t count = _hashes->SaveAll ? this->size() : this->count();
     writer.Stream() << "StringTableStart v1 " << count << '\n';
     saveStream(writer.Stream());
@@ -597,6 +652,7 @@ void StringHasher::RestoreDocFile(Base::Reader& reader)
     std::string ver;
     reader >> marker;
     std::size_t count = 0;
+    HasherLock lock(_hashes->Mutex);
     _hashes->clear();
     if (marker == "StringTableStart") {
         reader >> ver >> count;
@@ -729,6 +785,7 @@ void StringHasher::restoreStreamNew(std::istream& stream, std::size_t count)
 StringID* StringHasher::insert(const StringIDRef& sid)
 {
     assert(sid && sid._sid->_hasher == nullptr);
+    HasherLock lock(_hashes->Mutex);
     auto& hasher = *sid._sid;
     hasher._hasher = this;
     hasher.ref();
@@ -762,6 +819,7 @@ void StringHasher::restoreStream(std::istream& stream, std::size_t count)
 
 void StringHasher::clear()
 {
+    HasherLock lock(_hashes->Mutex);
     for (auto& hasher : _hashes->right) {
         hasher.second->_hasher = nullptr;
         hasher.second->unref();
@@ -771,11 +829,13 @@ void StringHasher::clear()
 
 size_t StringHasher::size() const
 {
+    HasherLock lock(_hashes->Mutex);
     return _hashes->size();
 }
 
 size_t StringHasher::count() const
 {
+    HasherLock lock(_hashes->Mutex);
     size_t count = 0;
     for (auto& hasher : _hashes->right) {
         if (hasher.second->isMarked() || hasher.second->isPersistent()) {
@@ -788,6 +848,7 @@ size_t StringHasher::count() const
 void StringHasher::Restore(Base::XMLReader& reader)
 {
     clear();
+    HasherLock lock(_hashes->Mutex);
     reader.readElement("StringHasher");
     _hashes->SaveAll = reader.getAttribute<long>("saveall") != 0L;
     _hashes->Threshold = reader.getAttribute<int>("threshold");
@@ -854,6 +915,7 @@ PyObject* StringHasher::getPyObject()
 std::map<long, StringIDRef> StringHasher::getIDMap() const
 {
     std::map<long, StringIDRef> ret;
+    HasherLock lock(_hashes->Mutex);
     for (auto& hasher : _hashes->right) {
         ret.emplace_hint(ret.end(), hasher.first, StringIDRef(hasher.second));
     }
@@ -862,6 +924,7 @@ std::map<long, StringIDRef> StringHasher::getIDMap() const
 
 void StringHasher::clearMarks() const
 {
+    HasherLock lock(_hashes->Mutex);
     for (auto& hasher : _hashes->right) {
         hasher.second->_flags.setFlag(StringID::Flag::Marked, false);
     }
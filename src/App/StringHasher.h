@@ -27,6 +27,7 @@
 
 #include <bitset>
 #include <memory>
+#include <vector>
 
 #include <QByteArray>
 #include <QVector>
@@ -630,6 +631,8 @@ private:
 /// If the string is longer than a given threshold, instead of storing the string, its SHA1 hash is
 /// stored (and the original string discarded). This allows an upper threshold on the length of a
 /// stored string, while still effectively guaranteeing uniqueness in the table.
+///
+/// Use getIDs() to intern many strings at once.
 class AppExport StringHasher: public Base::Persistence, public Base::Handled
 {
 
@@ -706,6 +709,30 @@ public:
     /** Map geometry element name to an integer */
     StringIDRef getID(const Data::MappedName& name, const QVector<StringIDRef>& sids);
 
+    /** Map a batch of text or binary data to integers
+     *
+     * @param data: input data.
+     * @param options: options describing how to store the data, applied to every entry.
+     * @return The StringIDs in the same order as the input.
+     *
+     * Equivalent to calling getID() for each entry, but the table is locked only once for the
+     * whole batch.
+     *
+     * \sa getID (const QByteArray&, Options);
+     */
+    std::vector<StringIDRef> getIDs(const std::vector<QByteArray>& data,
+                                    Options options = Option::Hashable);
+
+    /** Map a batch of geometry element names to integers
+     *
+     * @param names: input names.
+     * @return The StringIDs in the same order as the input.
+     *
+     * Equivalent to calling getID() for each name without related StringIDs, but the table is
+     * locked only once for the whole batch.
+     */
+    std::vector<StringIDRef> getIDs(const std::vector<Data::MappedName>& names);
+
     /** Obtain the reference counted StringID object from numerical id
      *
      * @param id: string ID
@@ -25,7 +25,11 @@
 // From Boost 1.75 on the geometry component requires C++14
 #define BOOST_GEOMETRY_DISABLE_DEPRECATED_03_WARNING
 
+#include <atomic>
+#include <chrono>
+#include <exception>
 #include <limits>
+#include <thread>
 
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/register/point.hpp>
@@ -1727,7 +1731,7 @@ std::vector<shared_ptr<Area>> Area::makeSections(PARAM_ARGS(PARAM_FARG, AREA_PAR
         throw Base::ValueError("failed to obtain section plane");
     }
 
-    FC_TIME_INIT2(t, t1);
+    FC_TIME_INIT(t);
 
     TopLoc_Location loc(trsf);
 
@@ -1886,7 +1890,10 @@ std::vector<shared_ptr<Area>> Area::makeSections(PARAM_ARGS(PARAM_FARG, AREA_PAR
     bool can_retry = fabs(tolerance) > Precision::Confusion();
     TopLoc_Location locInverse(loc.Inverted());
 
-    for (size_t i = 0; i < heights.size(); ++i) {
+    // Makes the section at heights[i]. Warnings are collected instead of reported, because
+    // sections may be made on worker threads. Returns null if the section is discarded.
+    auto makeSection = [&](size_t i, std::vector<std::string>& warnings) -> shared_ptr<Area> {
+        FC_TIME_INIT(t1);
         double z = heights[i];
         bool retried = !can_retry;
         while (true) {
@@ -1907,8 +1914,7 @@ std::vector<shared_ptr<Area>> Area::makeSections(PARAM_ARGS(PARAM_FARG, AREA_PAR
                     TopLoc_Location wloc(t);
                     area->add(s.shape.Moved(wloc).Moved(locInverse), s.op);
                 }
-                sections.push_back(area);
-                break;
+                return area;
             }
 
             for (auto it = myShapes.begin(); it != myShapes.end(); ++it) {
@@ -1921,13 +1927,10 @@ std::vector<shared_ptr<Area>> Area::makeSections(PARAM_ARGS(PARAM_FARG, AREA_PAR
                     showShape(xp.Current(), nullptr, "section_%zu_shape", i);
                     std::list<TopoDS_Wire> wires;
                     Part::CrossSection section(a, b, c, xp.Current());
-                    Part::FuzzyHelper::withBooleanFuzzy(.0, [&]() {
-                        // Workaround for https://github.com/FreeCAD/FreeCAD/issues/17748
-                        // needed to make finish pass work.
-                        // This fix might be better to move into Part::CrossSection but it is kept
-                        // here for now to be on the safe side.
-                        wires = section.slice(-d);
-                    });
+                    // The boolean fuzzy value is set to zero by the caller as a workaround for
+                    // https://github.com/FreeCAD/FreeCAD/issues/17748, needed to make finish
+                    // pass work.
+                    wires = section.slice(-d);
                     showShapes(wires, nullptr, "section_%zu_wire", i);
                     if (wires.empty()) {
                         AREA_LOG("Section returns no wires");
@@ -1946,7 +1949,7 @@ std::vector<shared_ptr<Area>> Area::makeSections(PARAM_ARGS(PARAM_FARG, AREA_PAR
                         mkFace.Build();
                         const TopoDS_Shape& shape = mkFace.Shape();
                         if (shape.IsNull()) {
-                            AREA_WARN("FaceMakerBullseye return null shape on section");
+                            warnings.emplace_back("FaceMakerBullseye return null shape on section");
                         }
                         else {
                             showShape(shape, nullptr, "section_%zu_face", i);
@@ -1967,7 +1970,8 @@ std::vector<shared_ptr<Area>> Area::makeSections(PARAM_ARGS(PARAM_FARG, AREA_PAR
                         }
                     }
                     catch (Base::Exception& e) {
-                        AREA_WARN("FaceMakerBullseye failed on section: " << e.what());
+                        warnings.push_back(std::string("FaceMakerBullseye failed on section: ")
+                                           + e.what());
                     }
                     for (const TopoDS_Wire& wire : wires) {
                         builder.Add(comp, wire);
@@ -1990,20 +1994,69 @@ std::vector<shared_ptr<Area>> Area::makeSections(PARAM_ARGS(PARAM_FARG, AREA_PAR
                 }
             }
             if (!area->myShapes.empty()) {
-                sections.push_back(area);
                 FC_TIME_LOG(t1, "makeSection " << z);
-                showShape(area->getShape(), nullptr, "section_%zu_final", i);
-                break;
+                if (FC_LOG_INSTANCE.level() > FC_LOGLEVEL_TRACE) {
+                    showShape(area->getShape(), nullptr, "section_%zu_final", i);
+                }
+                return area;
             }
             if (retried) {
-                AREA_WARN("Discard empty section");
-                break;
+                warnings.emplace_back("Discard empty section");
+                return nullptr;
             }
-            else {
-                AREA_TRACE("retry section " << z << "->" << z + tolerance);
-                z += tolerance;
-                retried = true;
+            AREA_TRACE("retry section " << z << "->" << z + tolerance);
+            z += tolerance;
+            retried = true;
+        }
+    };
+
+    std::vector<shared_ptr<Area>> levels(heights.size());
+    std::vector<std::vector<std::string>> levelWarnings(heights.size());
+    std::vector<std::exception_ptr> levelErrors(heights.size());
+
+    // Sections at different heights do not depend on each other, and slicing the solids is
+    // the expensive part, so the heights are sliced on several threads. Debug output adds
+    // document objects and is printed as it happens, so it keeps everything on this thread.
+    size_t threadCount = std::min<size_t>(std::thread::hardware_concurrency(), heights.size());
+    if (project || FC_LOG_INSTANCE.isEnabled(FC_LOGLEVEL_LOG)) {
+        threadCount = 1;
+    }
+    Part::FuzzyHelper::withBooleanFuzzy(.0, [&]() {
+        std::atomic<size_t> next = 0;
+        auto work = [&]() {
+            for (size_t i = next++; i < heights.size(); i = next++) {
+                try {
+                    levels[i] = makeSection(i, levelWarnings[i]);
+                }
+                catch (...) {
+                    levelErrors[i] = std::current_exception();
+                    next = heights.size();
+                }
             }
+        };
+        if (threadCount < 2) {
+            work();
+            return;
+        }
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i) {
+            threads.emplace_back(work);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    });
+
+    for (size_t i = 0; i < heights.size(); ++i) {
+        for (const auto& warning : levelWarnings[i]) {
+            AREA_WARN(warning);
+        }
+        if (levelErrors[i]) {
+            std::rethrow_exception(levelErrors[i]);
+        }
+        if (levels[i]) {
+            sections.push_back(levels[i]);
         }
     }
     FC_TIME_LOG(t, "makeSection count: " << sections.size() << ", total");
@@ -3002,6 +3055,7 @@ struct ShapeInfo
     Wires myWires;
     RTree myRTree;
     TopoDS_Shape myShape;
+    Bnd_Box myBound;
     gp_Pnt myBestPt;
     gp_Pnt myStartPt;
     Wires::iterator myBestWire;
@@ -3318,6 +3372,90 @@ struct ShapeInfo
     }
 };
 
+using ShapeBox = bg::model::box<gp_Pnt>;
+
+static inline ShapeBox getShapeBox(const Bnd_Box& bound)
+{
+    if (bound.IsVoid()) {
+        // no geometry, make sure the shape is never skipped
+        return ShapeBox(gp_Pnt(-1e100, -1e100, -1e100), gp_Pnt(1e100, 1e100, 1e100));
+    }
+    Standard_Real xMin, yMin, zMin, xMax, yMax, zMax;
+    bound.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+    return ShapeBox(gp_Pnt(xMin, yMin, zMin), gp_Pnt(xMax, yMax, zMax));
+}
+
+static inline double squareDistance(const gp_Pnt& pt, const ShapeBox& box)
+{
+    double d = 0;
+    for (int i = 1; i <= 3; ++i) {
+        double v = pt.Coord(i);
+        double lo = box.min_corner().Coord(i);
+        double hi = box.max_corner().Coord(i);
+        double diff = v < lo ? lo - v : (v > hi ? v - hi : 0.0);
+        d += diff * diff;
+    }
+    return d;
+}
+
+// Improve the order of the given closed wires with 2-opt moves, keeping the
+// first wire in place, until no move shortens the travel or the deadline
+// passes. Closed wires end where they start, so reversing a run of them only
+// changes the travel in between.
+static void refineWireOrder(std::list<TopoDS_Shape>& wires,
+                            gp_Pnt& pend,
+                            const std::chrono::steady_clock::time_point& deadline)
+{
+    if (wires.size() < 3) {
+        return;
+    }
+    std::vector<TopoDS_Shape> shapes;
+    std::vector<gp_Pnt> pts;
+    shapes.reserve(wires.size());
+    pts.reserve(wires.size());
+    for (auto& wire : wires) {
+        if (!BRep_Tool::IsClosed(wire)) {
+            return;
+        }
+        gp_Pnt p1, p2;
+        getEndPoints(TopoDS::Wire(wire), p1, p2);
+        shapes.push_back(wire);
+        pts.push_back(p1);
+    }
+
+    const std::size_t count = pts.size();
+    bool improved = true;
+    bool changed = false;
+    while (improved) {
+        improved = false;
+        for (std::size_t i = 1; i + 1 < count; ++i) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                improved = false;
+                break;
+            }
+            for (std::size_t j = i + 1; j < count; ++j) {
+                // replace travel (i-1 -> i) and (j -> j+1) by (i-1 -> j) and (i -> j+1)
+                double before = pts[i - 1].Distance(pts[i]);
+                double after = pts[i - 1].Distance(pts[j]);
+                if (j + 1 < count) {
+                    before += pts[j].Distance(pts[j + 1]);
+                    after += pts[i].Distance(pts[j + 1]);
+                }
+                if (after < before - Precision::Confusion()) {
+                    std::reverse(pts.begin() + i, pts.begin() + j + 1);
+                    std::reverse(shapes.begin() + i, shapes.begin() + j + 1);
+                    improved = changed = true;
+                }
+            }
+        }
+    }
+    if (!changed) {
+        return;
+    }
+    wires.assign(shapes.begin(), shapes.end());
+    pend = pts.back();
+}
+
 struct ShapeInfoBuilder
 {
     std::list<ShapeInfo>& myList;
@@ -3622,7 +3760,8 @@ std::list<TopoDS_Shape> Area::sortWires(const std::list<TopoDS_Shape>& shapes,
             }
         }
 
-        BRepBndLib::Add(info.myShape, bounds, Standard_False);
+        BRepBndLib::Add(info.myShape, info.myBound, Standard_False);
+        bounds.Add(info.myBound);
     }
 
     if (use_bound || sort_mode == SortMode2D5 || sort_mode == SortModeGreedy) {
@@ -3649,6 +3788,7 @@ std::list<TopoDS_Shape> Area::sortWires(const std::list<TopoDS_Shape>& shapes,
                     ++itNext;
                 }
                 builder.Add(comp, itNext2->myShape);
+                it->myBound.Add(itNext2->myBound);
                 shape_list.erase(itNext2);
                 empty = false;
             }
@@ -3695,6 +3835,21 @@ std::list<TopoDS_Shape> Area::sortWires(const std::list<TopoDS_Shape>& shapes,
     }
 
 
+    // Index the shape bounds so that shapes which can't be closer than the
+    // best one found so far are skipped without the costly nearest() search.
+    using ShapeValue = std::pair<ShapeBox, std::list<ShapeInfo>::iterator>;
+    bgi::rtree<ShapeValue, RParameters> shapeTree;
+    std::map<const ShapeInfo*, std::size_t> shapeOrder;
+    for (auto it = shape_list.begin(); it != shape_list.end(); ++it) {
+        shapeTree.insert(ShapeValue(getShapeBox(it->myBound), it));
+        shapeOrder.emplace(&(*it), shapeOrder.size());
+    }
+
+    // one day is as good as forever, and keeps the duration cast from overflowing
+    auto deadline = std::chrono::steady_clock::now()
+        + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(std::min(sort_time, 86400.0)));
+
     gp_Pln pln;
     double hint = 0.0;
     bool hint_first = true;
@@ -3705,18 +3860,33 @@ std::list<TopoDS_Shape> Area::sortWires(const std::list<TopoDS_Shape>& shapes,
         AREA_TRACE("sorting " << shape_list.size() << ' ' << AREA_XYZ(pstart));
         double best_d = std::numeric_limits<double>::max();
         auto best_it = shape_list.begin();
-        for (auto it = best_it; it != shape_list.end(); ++it) {
-            double d;
-            gp_Pnt pt;
-            if (it->myPlanar && current_it == shape_list.end()) {
-                d = it->myPln.SquareDistance(pstart);
-            }
-            else {
-                d = it->nearest(pstart);
-            }
-            if (d < best_d) {
+        std::size_t best_order = std::numeric_limits<std::size_t>::max();
+        // ties go to the shape that comes first in the list
+        auto check = [&](std::list<ShapeInfo>::iterator it, double d) {
+            std::size_t order = shapeOrder[&(*it)];
+            if (d < best_d || (d == best_d && order < best_order)) {
                 best_it = it;
                 best_d = d;
+                best_order = order;
+            }
+        };
+        bool byPlane = current_it == shape_list.end();
+        if (byPlane) {
+            for (auto it = shape_list.begin(); it != shape_list.end(); ++it) {
+                if (it->myPlanar) {
+                    check(it, it->myPln.SquareDistance(pstart));
+                }
+            }
+        }
+        constexpr int intMax = std::numeric_limits<int>::max();
+        for (auto vit = shapeTree.qbegin(bgi::nearest(pstart, intMax)); vit != shapeTree.qend();
+             ++vit) {
+            if (squareDistance(pstart, vit->first) > best_d) {
+                break;
+            }
+            auto it = vit->second;
+            if (!byPlane || !it->myPlanar) {
+                check(it, it->nearest(pstart));
             }
         }
         gp_Pnt pentry;
@@ -3737,7 +3907,11 @@ std::list<TopoDS_Shape> Area::sortWires(const std::list<TopoDS_Shape>& shapes,
             }
         }
 
-        wires.splice(wires.end(), best_it->sortWires(pstart, pend, min_dist, max_dist, &pentry));
+        auto sorted = best_it->sortWires(pstart, pend, min_dist, max_dist, &pentry);
+        if (sort_time > 0) {
+            refineWireOrder(sorted, pend, deadline);
+        }
+        wires.splice(wires.end(), sorted);
 
         if (use_bound && _pstart) {
             use_bound = false;
@@ -3778,6 +3952,7 @@ std::list<TopoDS_Shape> Area::sortWires(const std::list<TopoDS_Shape>& shapes,
             if (current_it == best_it) {
                 current_it = shape_list.end();
             }
+            shapeTree.remove(ShapeValue(getShapeBox(best_it->myBound), best_it));
             shape_list.erase(best_it);
         }
     }
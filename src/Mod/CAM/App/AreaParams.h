@@ -382,7 +382,14 @@
          nearest_k,                                                                                \
          NearestK,                                                                                 \
          3,                                                                                        \
-         "Nearest k sampling vertices are considered during sorting"))                             \
+         "Nearest k sampling vertices are considered during sorting"))(                            \
+        (double,                                                                                   \
+         sort_time,                                                                                \
+         SortTime,                                                                                 \
+         0.0,                                                                                      \
+         "Time limit in seconds to improve the sorted order of closed wires with 2-opt\n"          \
+         "moves. Zero disables the improvement.",                                                  \
+         App::PropertyFloat))                                                                      \
         AREA_PARAMS_ORIENTATION(                                                                   \
             (enum,                                                                                 \
              direction,                                                                            \
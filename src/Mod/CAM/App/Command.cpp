@@ -44,7 +44,7 @@ TYPESYSTEM_SOURCE(Path::Command, Base::Persistence)
 
 Command::Command(const char* name, const std::map<std::string, double>& parameters)
     : Name(name)
-    , Parameters(parameters)
+    , Parameters(parameters.begin(), parameters.end())
 {}
 
 Command::Command()
@@ -103,9 +103,7 @@ std::string Command::toGCode(int precision, bool padzero) const
     }
     double scale = std::pow(10.0, precision + 1);
     std::int64_t iscale = static_cast<std::int64_t>(scale) / 10;
-    for (std::map<std::string, double>::const_iterator i = Parameters.begin();
-         i != Parameters.end();
-         ++i) {
+    for (auto i = Parameters.begin(); i != Parameters.end(); ++i) {
         if (i->first == "N") {
             continue;
         }
@@ -140,69 +138,76 @@ std::string Command::toGCode(int precision, bool padzero) const
     return str.str();
 }
 
-void Command::setFromGCode(const std::string& str)
+void Command::setFromGCode(std::string_view str)
 {
+    enum class Mode
+    {
+        None,
+        Command,
+        Argument,
+        Comment
+    };
+
     Parameters.clear();
-    std::string mode = "none";
+    Mode mode = Mode::None;
     std::string key;
     std::string value;
-    for (unsigned int i = 0; i < str.size(); i++) {
-        if ((isdigit(str[i])) || (str[i] == '-') || (str[i] == '.')) {
-            value += str[i];
+    for (char c : str) {
+        if ((isdigit(c)) || (c == '-') || (c == '.')) {
+            value += c;
         }
-        else if (isalpha(str[i])) {
-            if (mode == "command") {
+        else if (isalpha(c)) {
+            if (mode == Mode::Command) {
                 if (!key.empty() && !value.empty()) {
                     std::string cmd = key + value;
                     boost::to_upper(cmd);
                     Name = cmd;
-                    key = "";
-                    value = "";
-                    mode = "argument";
+                    key.clear();
+                    value.clear();
                 }
                 else {
                     throw Base::BadFormatError("Badly formatted GCode command");
                 }
-                mode = "argument";
+                mode = Mode::Argument;
             }
-            else if (mode == "none") {
-                mode = "command";
+            else if (mode == Mode::None) {
+                mode = Mode::Command;
             }
-            else if (mode == "argument") {
+            else if (mode == Mode::Argument) {
                 if (!key.empty() && !value.empty()) {
                     double val = std::atof(value.c_str());
                     boost::to_upper(key);
                     Parameters[key] = val;
-                    key = "";
-                    value = "";
+                    key.clear();
+                    value.clear();
                 }
                 else {
                     throw Base::BadFormatError("Badly formatted GCode argument");
                 }
             }
-            else if (mode == "comment") {
-                value += str[i];
+            else if (mode == Mode::Comment) {
+                value += c;
             }
-            key = str[i];
+            key = c;
         }
-        else if (str[i] == '(') {
-            mode = "comment";
+        else if (c == '(') {
+            mode = Mode::Comment;
         }
-        else if (str[i] == ')') {
+        else if (c == ')') {
             key = "(";
             value += ")";
         }
         else {
             // add non-ascii characters only if this is a comment
-            if (mode == "comment") {
-                value += str[i];
+            if (mode == Mode::Comment) {
+                value += c;
             }
         }
     }
     if (!key.empty() && !value.empty()) {
-        if ((mode == "command") || (mode == "comment")) {
+        if ((mode == Mode::Command) || (mode == Mode::Comment)) {
             std::string cmd = key + value;
-            if (mode == "command") {
+            if (mode == Mode::Command) {
                 boost::to_upper(cmd);
             }
             Name = cmd;
@@ -284,9 +289,7 @@ Command Command::transform(const Base::Placement& other)
     plac.getRotation().getYawPitchRoll(aval, bval, cval);
     Command c = Command();
     c.Name = Name;
-    for (std::map<std::string, double>::const_iterator i = Parameters.begin();
-         i != Parameters.end();
-         ++i) {
+    for (auto i = Parameters.begin(); i != Parameters.end(); ++i) {
         std::string k = i->first;
         double v = i->second;
         if (k == "X") {
@@ -314,9 +317,7 @@ Command Command::transform(const Base::Placement& other)
 
 void Command::scaleBy(double factor)
 {
-    for (std::map<std::string, double>::const_iterator i = Parameters.begin();
-         i != Parameters.end();
-         ++i) {
+    for (auto i = Parameters.begin(); i != Parameters.end(); ++i) {
         switch (i->first[0]) {
             case 'X':
             case 'Y':
@@ -326,7 +327,7 @@ void Command::scaleBy(double factor)
             case 'R':
             case 'Q':
             case 'F':
-                Parameters[i->first] = i->second * factor;
+                i->second *= factor;
                 break;
         }
     }
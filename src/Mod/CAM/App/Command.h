@@ -27,6 +27,9 @@
 
 #include <map>
 #include <string>
+#include <string_view>
+#include <boost/container/flat_map.hpp>
+#include <boost/container/small_vector.hpp>
 #include <Base/Persistence.h>
 #include <Base/Placement.h>
 #include <Base/Vector3D.h>
@@ -34,6 +37,13 @@
 
 namespace Path
 {
+/** The parameters of a cnc command, keyed and ordered by name like a std::map
+ *
+ * Kept as a sorted vector with inline room for the usual handful of words, so that a typical
+ * command does not allocate for its parameters.
+ */
+using CommandParameters = boost::container::small_flat_map<std::string, double, 4>;
+
 /** The representation of a cnc command in a path */
 class PathExport Command: public Base::Persistence
 {
@@ -59,7 +69,7 @@ public:
     toGCode(int precision = 6,
             bool padzero = true) const;  // returns a GCode string representation of the command
     void setFromGCode(
-        const std::string&);  // sets the parameters from the contents of the given GCode string
+        std::string_view);  // sets the parameters from the contents of the given GCode string
     void setFromPlacement(
         const Base::Placement&);  // sets the parameters from the contents of the given placement
     bool
@@ -77,7 +87,7 @@ public:
 
     // attributes
     std::string Name;
-    std::map<std::string, double> Parameters;
+    CommandParameters Parameters;
 };
 
 }  // namespace Path
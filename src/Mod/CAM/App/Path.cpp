@@ -22,6 +22,11 @@
  ***************************************************************************/
 
 
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <thread>
+
 #include <App/Application.h>
 #include <Base/Console.h>
 #include <Base/Reader.h>
@@ -85,7 +90,7 @@ void Toolpath::addCommand(const Command& Cmd)
 {
     Command* tmp = new Command(Cmd);
     vpcCommands.push_back(tmp);
-    recalculate();
+    invalidate(vpcCommands.size() - 1);
 }
 
 void Toolpath::insertCommand(const Command& Cmd, int pos)
@@ -96,11 +101,11 @@ void Toolpath::insertCommand(const Command& Cmd, int pos)
     else if (pos <= static_cast<int>(vpcCommands.size())) {
         Command* tmp = new Command(Cmd);
         vpcCommands.insert(vpcCommands.begin() + pos, tmp);
+        invalidate(pos);
     }
     else {
         throw Base::IndexError("Index not in range");
     }
-    recalculate();
 }
 
 void Toolpath::deleteCommand(int pos)
@@ -108,43 +113,93 @@ void Toolpath::deleteCommand(int pos)
     if (pos == -1) {
         // delete(*vpcCommands.rbegin()); // causes crash
         vpcCommands.pop_back();
+        invalidate(vpcCommands.size());
     }
     else if (pos <= static_cast<int>(vpcCommands.size())) {
         vpcCommands.erase(vpcCommands.begin() + pos);
+        invalidate(pos);
     }
     else {
         throw Base::IndexError("Index not in range");
     }
-    recalculate();
 }
 
-double Toolpath::getLength()
+void Toolpath::invalidate(std::size_t pos)
 {
-    if (vpcCommands.empty()) {
-        return 0;
+    if (pos < totals.size()) {
+        totals.resize(pos);
     }
-    double l = 0;
-    Vector3d last(0, 0, 0);
-    Vector3d next;
-    for (std::vector<Command*>::const_iterator it = vpcCommands.begin(); it != vpcCommands.end();
-         ++it) {
-        std::string name = (*it)->Name;
-        next = (*it)->getPlacement(last).getPosition();
-        if ((name == "G0") || (name == "G00") || (name == "G1") || (name == "G01")) {
-            // straight line
-            l += (next - last).Length();
-            last = next;
+    boundBoxValid = false;
+}
+
+static inline bool isRapid(const std::string& name)
+{
+    return name == "G0" || name == "G00";
+}
+
+static inline bool isFeed(const std::string& name)
+{
+    return name == "G1" || name == "G01";
+}
+
+static inline bool isArc(const std::string& name)
+{
+    return name == "G2" || name == "G02" || name == "G3" || name == "G03";
+}
+
+static inline double arcLength(const Command& cmd, const Vector3d& last, const Vector3d& next)
+{
+    Vector3d center = cmd.getCenter();
+    double radius = (last - center).Length();
+    double angle = (next - center).GetAngle(last - center);
+    return angle * radius;
+}
+
+const Toolpath::Totals& Toolpath::getTotals() const
+{
+    static const Totals empty;
+    if (vpcCommands.empty()) {
+        return empty;
+    }
+    totals.reserve(vpcCommands.size());
+    for (std::size_t i = totals.size(); i < vpcCommands.size(); ++i) {
+        Totals t = totals.empty() ? empty : totals.back();
+        const Command& cmd = *vpcCommands[i];
+        const std::string& name = cmd.Name;
+
+        // the length only follows the moves
+        Vector3d next = cmd.getPlacement(t.lastMove).getPosition();
+        if (isRapid(name) || isFeed(name)) {
+            t.length += (next - t.lastMove).Length();
+            t.lastMove = next;
+        }
+        else if (isArc(name)) {
+            t.length += arcLength(cmd, t.lastMove, next);
+            t.lastMove = next;
+        }
+
+        // while the cycle time follows every command
+        next = cmd.getPlacement(t.last).getPosition();
+        bool verticalMove = t.last.z != next.z;
+        if (isRapid(name)) {
+            (verticalMove ? t.verticalRapid : t.rapid) += (next - t.last).Length();
+        }
+        else if (isFeed(name)) {
+            (verticalMove ? t.verticalFeed : t.feed) += (next - t.last).Length();
         }
-        else if ((name == "G2") || (name == "G02") || (name == "G3") || (name == "G03")) {
-            // arc
-            Vector3d center = (*it)->getCenter();
-            double radius = (last - center).Length();
-            double angle = (next - center).GetAngle(last - center);
-            l += angle * radius;
-            last = next;
+        else if (isArc(name)) {
+            (verticalMove ? t.verticalFeed : t.feed) += arcLength(cmd, t.last, next);
         }
+        t.last = next;
+
+        totals.push_back(t);
     }
-    return l;
+    return totals.back();
+}
+
+double Toolpath::getLength()
+{
+    return getTotals().length;
 }
 
 double Toolpath::getCycleTime(double hFeed, double vFeed, double hRapid, double vRapid)
@@ -167,53 +222,9 @@ double Toolpath::getCycleTime(double hFeed, double vFeed, double hRapid, double
         vRapid = vFeed;
     }
 
-    if (vpcCommands.empty()) {
-        return 0;
-    }
-    double l = 0;
-    double time = 0;
-    bool verticalMove = false;
-    Vector3d last(0, 0, 0);
-    Vector3d next;
-    for (std::vector<Command*>::const_iterator it = vpcCommands.begin(); it != vpcCommands.end();
-         ++it) {
-        std::string name = (*it)->Name;
-        float feedrate = (*it)->getParam("F");
-
-        l = 0;
-        verticalMove = false;
-        feedrate = hFeed;
-        next = (*it)->getPlacement(last).getPosition();
-
-        if (last.z != next.z) {
-            verticalMove = true;
-            feedrate = vFeed;
-        }
-
-        if ((name == "G0") || (name == "G00")) {
-            // Rapid Move
-            l += (next - last).Length();
-            feedrate = hRapid;
-            if (verticalMove) {
-                feedrate = vRapid;
-            }
-        }
-        else if ((name == "G1") || (name == "G01")) {
-            // Feed Move
-            l += (next - last).Length();
-        }
-        else if ((name == "G2") || (name == "G02") || (name == "G3") || (name == "G03")) {
-            // Arc Move
-            Vector3d center = (*it)->getCenter();
-            double radius = (last - center).Length();
-            double angle = (next - center).GetAngle(last - center);
-            l += angle * radius;
-        }
-
-        time += l / feedrate;
-        last = next;
-    }
-    return time;
+    const Totals& t = getTotals();
+    return t.feed / hFeed + t.verticalFeed / vFeed + t.rapid / hRapid
+        + t.verticalRapid / vRapid;
 }
 
 class BoundBoxSegmentVisitor: public PathSegmentVisitor
@@ -297,85 +308,193 @@ private:
 
 Base::BoundBox3d Toolpath::getBoundBox() const
 {
-    BoundBoxSegmentVisitor visitor;
-    PathSegmentWalker walker(*this);
-    walker.walk(visitor, Vector3d(0, 0, 0));
-
-    return visitor.bb;
+    // the walker discretizes arcs according to the mesh deviation
+    ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Part");
+    double deviation = hGrp->GetFloat("MeshDeviation", 0.2);
+    if (!boundBoxValid || deviation != boundBoxDeviation) {
+        boundBoxDeviation = deviation;
+        BoundBoxSegmentVisitor visitor;
+        PathSegmentWalker walker(*this);
+        walker.walk(visitor, Vector3d(0, 0, 0));
+        boundBox = visitor.bb;
+        boundBoxValid = true;
+    }
+    return boundBox;
 }
 
-static void
-bulkAddCommand(const std::string& gcodestr, std::vector<Command*>& commands, bool& inches)
-{
-    Command* cmd = new Command();
-    cmd->setFromGCode(gcodestr);
-    if ("G20" == cmd->Name) {
-        inches = true;
-        delete cmd;
-    }
-    else if ("G21" == cmd->Name) {
-        inches = false;
-        delete cmd;
-    }
-    else {
-        if (inches) {
-            cmd->scaleBy(25.4);
-        }
-        commands.push_back(cmd);
-    }
-}
+// Below this many commands per thread, parsing is faster than starting the threads
+static const std::size_t MinCommandsPerThread = 4096;
+// Amount of text read from a stream before the commands found in it are parsed
+static const std::size_t GCodeBlockSize = 1 << 20;
 
-void Toolpath::setFromGCode(const std::string instr)
+// State of splitGCode() carried over from one block of input to the next
+struct GCodeScan
 {
-    clear();
+    std::size_t pos = 0;   // offset at which to continue scanning
+    bool open = false;     // the text starts with an unfinished command or comment
+    bool comment = false;  // the unfinished chunk is a comment
+};
 
-    // remove comments
-    // boost::regex e("\\(.*?\\)");
-    // std::string str = boost::regex_replace(instr, e, "");
-    std::string str(instr);
+// Splits a GCode program by () or G or M commands, without copying the text. Unless final is
+// set, a trailing command or comment that may continue in the next block of input is not
+// emitted, and scan is set up to continue after the text already scanned once the next block
+// has been appended to the unconsumed rest. Returns the offset up to which the text has been
+// consumed.
+static std::size_t splitGCode(std::string_view str,
+                              std::vector<std::string_view>& chunks,
+                              bool final,
+                              GCodeScan& scan)
+{
+    static constexpr std::string_view starts = "(gGmM";
+    constexpr std::size_t npos = std::string_view::npos;
 
-    // split input string by () or G or M commands
-    std::string mode = "command";
-    std::size_t found = str.find_first_of("(gGmM");
-    int last = -1;
-    bool inches = false;
-    while (found != std::string::npos) {
+    bool comment = scan.comment;
+    std::size_t last = scan.open ? 0 : npos;
+    std::size_t found = comment ? str.find(')', scan.pos) : str.find_first_of(starts, scan.pos);
+    while (found != npos) {
         if (str[found] == '(') {
             // start of comment
-            if ((last > -1) && (mode == "command")) {
+            if ((last != npos) && !comment) {
                 // before opening a comment, add the last found command
-                std::string gcodestr = str.substr(last, found - last);
-                bulkAddCommand(gcodestr, vpcCommands, inches);
+                chunks.push_back(str.substr(last, found - last));
             }
-            mode = "comment";
+            comment = true;
             last = found;
-            found = str.find_first_of(')', found + 1);
+            found = str.find(')', found + 1);
         }
         else if (str[found] == ')') {
             // end of comment
-            std::string gcodestr = str.substr(last, found - last + 1);
-            bulkAddCommand(gcodestr, vpcCommands, inches);
-            last = -1;
-            found = str.find_first_of("(gGmM", found + 1);
-            mode = "command";
+            chunks.push_back(str.substr(last, found - last + 1));
+            last = npos;
+            found = str.find_first_of(starts, found + 1);
+            comment = false;
         }
-        else if (mode == "command") {
+        else {
             // command
-            if (last > -1) {
-                std::string gcodestr = str.substr(last, found - last);
-                bulkAddCommand(gcodestr, vpcCommands, inches);
+            if (last != npos) {
+                chunks.push_back(str.substr(last, found - last));
             }
             last = found;
-            found = str.find_first_of("(gGmM", found + 1);
+            found = str.find_first_of(starts, found + 1);
+        }
+    }
+    if (last == npos) {
+        scan = GCodeScan();
+        return str.size();
+    }
+    if (!final) {
+        scan.pos = str.size() - last;
+        scan.open = true;
+        scan.comment = comment;
+        return last;
+    }
+    // add the last command found, if any; an unterminated comment is dropped
+    if (!comment) {
+        chunks.push_back(str.substr(last));
+    }
+    scan = GCodeScan();
+    return str.size();
+}
+
+// Parses the given chunks, spread over several threads for large programs, and appends the
+// resulting commands. The modal G20/G21 units are applied afterwards in a single linear pass.
+static void bulkAddCommands(const std::vector<std::string_view>& chunks,
+                            std::vector<Command*>& commands,
+                            bool& inches)
+{
+    std::vector<std::unique_ptr<Command>> parsed(chunks.size());
+    std::vector<std::exception_ptr> errors(chunks.size());
+    auto parse = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            try {
+                auto cmd = std::make_unique<Command>();
+                cmd->setFromGCode(chunks[i]);
+                parsed[i] = std::move(cmd);
+            }
+            catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    std::size_t threads = std::max(std::thread::hardware_concurrency(), 1U);
+    threads = std::min(threads, chunks.size() / MinCommandsPerThread);
+    if (threads > 1) {
+        std::size_t step = (chunks.size() + threads - 1) / threads;
+        std::vector<std::thread> workers;
+        workers.reserve(threads);
+        for (std::size_t begin = 0; begin < chunks.size(); begin += step) {
+            workers.emplace_back(parse, begin, std::min(begin + step, chunks.size()));
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+    else {
+        parse(0, chunks.size());
+    }
+
+    commands.reserve(commands.size() + chunks.size());
+    for (std::size_t i = 0; i < parsed.size(); ++i) {
+        // keep the commands before a bad one, like a sequential parse would
+        if (errors[i]) {
+            std::rethrow_exception(errors[i]);
+        }
+        if ("G20" == parsed[i]->Name) {
+            inches = true;
+        }
+        else if ("G21" == parsed[i]->Name) {
+            inches = false;
+        }
+        else {
+            if (inches) {
+                parsed[i]->scaleBy(25.4);
+            }
+            commands.push_back(parsed[i].release());
         }
     }
-    // add the last command found, if any
-    if (last > -1) {
-        if (mode == "command") {
-            std::string gcodestr = str.substr(last, std::string::npos);
-            bulkAddCommand(gcodestr, vpcCommands, inches);
+}
+
+void Toolpath::setFromGCode(const std::string& str)
+{
+    clear();
+
+    std::vector<std::string_view> chunks;
+    bool inches = false;
+    GCodeScan scan;
+    splitGCode(str, chunks, true, scan);
+    bulkAddCommands(chunks, vpcCommands, inches);
+    recalculate();
+}
+
+void Toolpath::setFromGCode(std::istream& stream)
+{
+    clear();
+
+    // the text is read by words and parsed block by block, the unfinished command at the end
+    // of a block is carried over to the next one
+    std::string buffer;
+    std::string word;
+    std::vector<std::string_view> chunks;
+    bool inches = false;
+    GCodeScan scan;
+    auto parseBuffer = [&](bool final) {
+        chunks.clear();
+        std::size_t consumed = splitGCode(buffer, chunks, final, scan);
+        bulkAddCommands(chunks, vpcCommands, inches);
+        buffer.erase(0, consumed);
+    };
+
+    buffer.reserve(GCodeBlockSize + GCodeBlockSize / 16);
+    while (stream >> word) {
+        buffer += word;
+        buffer += " ";
+        if (buffer.size() >= GCodeBlockSize) {
+            parseBuffer(false);
         }
     }
+    parseBuffer(true);
     recalculate();
 }
 
@@ -392,6 +511,7 @@ std::string Toolpath::toGCode() const
 
 void Toolpath::recalculate()  // recalculates the path cache
 {
+    invalidate(0);
 
     if (vpcCommands.empty()) {
         return;
@@ -517,11 +637,5 @@ void Toolpath::Restore(XMLReader& reader)
 
 void Toolpath::RestoreDocFile(Base::Reader& reader)
 {
-    std::string gcode;
-    std::string line;
-    while (reader >> line) {
-        gcode += line;
-        gcode += " ";
-    }
-    setFromGCode(gcode);
+    setFromGCode(reader);
 }
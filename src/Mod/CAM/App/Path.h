@@ -24,6 +24,9 @@
 #ifndef PATH_Path_H
 #define PATH_Path_H
 
+#include <istream>
+#include <vector>
+
 #include <Base/BoundBox.h>
 #include <Base/Persistence.h>
 #include <Base/Vector3D.h>
@@ -61,9 +64,10 @@ public:
     void deleteCommand(int);                              // deletes a command
     double getLength();                                   // return the Length (mm) of the Path
     double getCycleTime(double, double, double, double);  // return the Cycle Time (s) of the Path
-    void recalculate();                                   // recalculates the points
+    void recalculate();                                   // drops all cached statistics
     void
-    setFromGCode(const std::string);  // sets the path from the contents of the given GCode string
+    setFromGCode(const std::string&);  // sets the path from the contents of the given GCode string
+    void setFromGCode(std::istream&);  // sets the path from GCode read from the given stream
     std::string toGCode() const;      // gets a gcode string representation from the Path
     Base::BoundBox3d getBoundBox() const;
 
@@ -93,6 +97,29 @@ public:
 protected:
     std::vector<Command*> vpcCommands;
     Base::Vector3d center;
+
+    // Running totals after each command. They are computed on demand and only
+    // for the commands that changed since the last query, so appending to a
+    // path or editing its tail doesn't walk the whole path again. Commands must
+    // be modified through the interface above for the cache to stay valid.
+    struct Totals
+    {
+        Base::Vector3d lastMove;  // end point of the last move, as used for the length
+        Base::Vector3d last;      // position after the command, as used for the cycle time
+        double length = 0;
+        // distance travelled per feed rate used for the cycle time
+        double feed = 0;
+        double verticalFeed = 0;
+        double rapid = 0;
+        double verticalRapid = 0;
+    };
+    mutable std::vector<Totals> totals;  // valid for the first totals.size() commands
+    mutable Base::BoundBox3d boundBox;
+    mutable double boundBoxDeviation = 0;
+    mutable bool boundBoxValid = false;
+
+    void invalidate(std::size_t pos);
+    const Totals& getTotals() const;
     // KDL::Path_Composite *pcPath;
 
     /*
@@ -21,6 +21,12 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <iterator>
+#include <thread>
+
 #include <Base/Vector3D.h>
 #include <Base/Tools.h>
 
@@ -66,50 +72,27 @@ Base::Vector3d Voronoi::diagram_type::scaledVector(const vertex_type& v, double
 }
 
 
-int Voronoi::diagram_type::index(const Voronoi::diagram_type::cell_type* cell) const
+template<typename T>
+static int indexOf(const std::vector<T>& elements, const T* element)
 {
-    auto it = cell_index.find(intptr_t(cell));
-    if (it == cell_index.end()) {
+    if (!element || elements.empty() || element < &elements.front()
+        || element > &elements.back()) {
         return Voronoi::InvalidIndex;
     }
-    return it->second;
+    return int(element - &elements.front());
 }
-int Voronoi::diagram_type::index(const Voronoi::diagram_type::edge_type* edge) const
+
+int Voronoi::diagram_type::index(const Voronoi::diagram_type::cell_type* cell) const
 {
-    auto it = edge_index.find(intptr_t(edge));
-    if (it == edge_index.end()) {
-        return Voronoi::InvalidIndex;
-    }
-    return it->second;
+    return indexOf(cells(), cell);
 }
-int Voronoi::diagram_type::index(const Voronoi::diagram_type::vertex_type* vertex) const
+int Voronoi::diagram_type::index(const Voronoi::diagram_type::edge_type* edge) const
 {
-    auto it = vertex_index.find(intptr_t(vertex));
-    if (it == vertex_index.end()) {
-        return Voronoi::InvalidIndex;
-    }
-    return it->second;
+    return indexOf(edges(), edge);
 }
-
-void Voronoi::diagram_type::reIndex()
+int Voronoi::diagram_type::index(const Voronoi::diagram_type::vertex_type* vertex) const
 {
-    int idx = 0;
-    cell_index.clear();
-    edge_index.clear();
-    vertex_index.clear();
-
-    idx = 0;
-    for (auto it = cells().begin(); it != cells().end(); ++it, ++idx) {
-        cell_index[intptr_t(&(*it))] = idx;
-    }
-    idx = 0;
-    for (auto it = edges().begin(); it != edges().end(); ++it, ++idx) {
-        edge_index[intptr_t(&(*it))] = idx;
-    }
-    idx = 0;
-    for (auto it = vertices().begin(); it != vertices().end(); ++it, ++idx) {
-        vertex_index[intptr_t(&(*it))] = idx;
-    }
+    return indexOf(vertices(), vertex);
 }
 
 Voronoi::point_type
@@ -137,6 +120,46 @@ Voronoi::diagram_type::retrieveSegment(const Voronoi::diagram_type::cell_type* c
     return segments[index];
 }
 
+static double distanceBetween(double x0, double y0, double x1, double y1)
+{
+    return sqrt((x0 - x1) * (x0 - x1) + (y0 - y1) * (y0 - y1));
+}
+
+bool Voronoi::diagram_type::isBorderline(const Voronoi::diagram_type::edge_type* edge) const
+{
+    if (edge->is_linear()) {
+        return false;
+    }
+    // a curved edge is always formed by a point and a segment, if the point is one of the end
+    // points of the segment the edge degenerates
+    bool pointFirst = edge->cell()->contains_point();
+    Voronoi::point_type point = retrievePoint(pointFirst ? edge->cell() : edge->twin()->cell());
+    Voronoi::segment_type segment =
+        retrieveSegment(pointFirst ? edge->twin()->cell() : edge->cell());
+    double tolerance = 1e-6 * scale;
+    return distanceBetween(point.x(), point.y(), low(segment).x(), low(segment).y()) < tolerance
+        || distanceBetween(point.x(), point.y(), high(segment).x(), high(segment).y()) < tolerance;
+}
+
+double Voronoi::diagram_type::distanceToSource(const Voronoi::diagram_type::edge_type* edge,
+                                               const Voronoi::vertex_type* vertex) const
+{
+    const cell_type* c0 = edge->cell();
+    const cell_type* c1 = edge->twin()->cell();
+    if (c0->contains_point() || c1->contains_point()) {
+        Voronoi::point_type p = retrievePoint(c0->contains_point() ? c0 : c1);
+        return distanceBetween(vertex->x(), vertex->y(), p.x(), p.y()) / scale;
+    }
+    // both cells are sourced from segments, and both are equally far away
+    Voronoi::segment_type segment = retrieveSegment(c0);
+    double dx = high(segment).x() - low(segment).x();
+    double dy = high(segment).y() - low(segment).y();
+    double px = vertex->x() - low(segment).x();
+    double py = vertex->y() - low(segment).y();
+    double proj = (px * dx + py * dy) / (dx * dx + dy * dy + std::numeric_limits<double>::epsilon());
+    return distanceBetween(px, py, proj * dx, proj * dy) / scale;
+}
+
 
 // Voronoi
 
@@ -200,7 +223,42 @@ void Voronoi::construct()
                       vd->segments.begin(),
                       vd->segments.end(),
                       static_cast<voronoi_diagram_type*>(vd));
-    vd->reIndex();
+}
+
+void Voronoi::construct(const std::vector<Voronoi*>& diagrams)
+{
+    std::vector<Voronoi*> todo(diagrams);
+    std::sort(todo.begin(), todo.end());
+    todo.erase(std::unique(todo.begin(), todo.end()), todo.end());
+
+    std::vector<std::exception_ptr> errors(todo.size());
+    std::atomic<std::size_t> next(0);
+    auto worker = [&]() {
+        for (std::size_t i = next++; i < todo.size(); i = next++) {
+            try {
+                todo[i]->construct();
+            }
+            catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+
+    std::size_t threadCount =
+        std::min<std::size_t>(todo.size(), std::max(1U, std::thread::hardware_concurrency()));
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < threadCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
 }
 
 void Voronoi::colorExterior(const Voronoi::diagram_type::edge_type* edge, std::size_t colorValue)
@@ -335,3 +393,195 @@ void Voronoi::resetColor(Voronoi::color_type color)
         }
     }
 }
+
+void Voronoi::colorByType(Voronoi::color_type primary,
+                          Voronoi::color_type secondary,
+                          Voronoi::color_type borderline)
+{
+    for (auto it = vd->edges().begin(); it != vd->edges().end(); ++it) {
+        if (!it->is_primary()) {
+            it->color(secondary & ColorMask);
+        }
+        else if (it->is_finite() && vd->isBorderline(&(*it))) {
+            it->color(borderline & ColorMask);
+        }
+        else {
+            it->color(primary & ColorMask);
+        }
+    }
+}
+
+std::vector<Voronoi::EdgeWire> Voronoi::wires(Voronoi::color_type color) const
+{
+    using edge_type = diagram_type::edge_type;
+
+    // incident edges per vertex, and the vertices in the order they were first encountered
+    std::vector<std::vector<const edge_type*>> incident(vd->num_vertices());
+    std::vector<int> order;
+    for (auto it = vd->edges().begin(); it != vd->edges().end(); ++it) {
+        if (it->is_infinite() || (it->color() & ColorMask) != color) {
+            continue;
+        }
+        for (auto v : {it->vertex0(), it->vertex1()}) {
+            auto& edges = incident[vd->index(v)];
+            if (edges.empty()) {
+                order.push_back(vd->index(v));
+            }
+            edges.push_back(&(*it));
+        }
+    }
+
+    // knots are the start and end points of a wire
+    std::vector<int> knots;
+    std::copy_if(order.begin(), order.end(), std::back_inserter(knots), [&](int i) {
+        return incident[i].size() == 1;
+    });
+    std::copy_if(order.begin(), order.end(), std::back_inserter(knots), [&](int i) {
+        return incident[i].size() > 2;
+    });
+    if (knots.empty() && !order.empty()) {
+        knots.push_back(order.front());
+    }
+
+    auto consume = [&](int v, const edge_type* edge) {
+        auto& edges = incident[v];
+        edges.erase(std::remove(edges.begin(), edges.end(), edge), edges.end());
+        return edges.empty();
+    };
+    auto removeKnot = [&](int v) {
+        knots.erase(std::remove(knots.begin(), knots.end(), v), knots.end());
+    };
+
+    std::vector<EdgeWire> result;
+    while (!knots.empty()) {
+        int first = knots.front();
+        int last = first;
+        if (!incident[first].empty()) {
+            EdgeWire wire;
+            int start = first;
+            while (start != InvalidIndex) {
+                last = start;
+                if (incident[start].empty()) {
+                    break;
+                }
+                const edge_type* edge = incident[start].front();
+                int end = InvalidIndex;
+                if (start == vd->index(edge->vertex0())) {
+                    end = vd->index(edge->vertex1());
+                    wire.push_back(edge);
+                }
+                else {
+                    end = vd->index(edge->vertex0());
+                    wire.push_back(edge->twin());
+                }
+                consume(start, edge);
+                start = consume(end, edge) ? InvalidIndex : end;
+            }
+            result.push_back(std::move(wire));
+        }
+        if (incident[first].empty()) {
+            removeKnot(first);
+        }
+        if (incident[last].empty()) {
+            removeKnot(last);
+        }
+    }
+    return result;
+}
+
+// Sample the parabola between the given vertices, which is equidistant to point and segment.
+// The samples exclude both end points and are appended to wire in order.
+static void discretizeParabola(const Voronoi::point_type& point,
+                               const Voronoi::segment_type& segment,
+                               const Voronoi::vertex_type& v0,
+                               const Voronoi::vertex_type& v1,
+                               double deflection,
+                               const Voronoi::diagram_type& dia,
+                               Voronoi::MedialAxisWire& wire)
+{
+    // work in the coordinate system of the segment, where the parabola is
+    // y = ((x - px)^2 + py^2) / (2 py)
+    double dx = high(segment).x() - low(segment).x();
+    double dy = high(segment).y() - low(segment).y();
+    double len = sqrt(dx * dx + dy * dy);
+    if (len <= 0) {
+        return;
+    }
+    dx /= len;
+    dy /= len;
+    auto toX = [&](double x, double y) {
+        return (x - low(segment).x()) * dx + (y - low(segment).y()) * dy;
+    };
+    double px = toX(point.x(), point.y());
+    double py = (point.y() - low(segment).y()) * dx - (point.x() - low(segment).x()) * dy;
+    if (py == 0) {
+        return;
+    }
+    auto toY = [&](double x) {
+        return ((x - px) * (x - px) + py * py) / (2 * py);
+    };
+
+    // recursively split the chord at the point of the arc farthest away from it
+    std::vector<double> xs {toX(v0.x(), v0.y()), toX(v1.x(), v1.y())};
+    std::vector<double> todo {xs.back()};
+    xs.pop_back();
+    const double tolerance = deflection * dia.getScale();
+    const std::size_t maxPoints = 10000;
+    while (!todo.empty()) {
+        double x0 = xs.back();
+        double x1 = todo.back();
+        double y0 = toY(x0);
+        double y1 = toY(x1);
+        double slope = (x1 == x0) ? 0 : (y1 - y0) / (x1 - x0);
+        double xm = px + slope * py;
+        double ym = toY(xm);
+        double dist = fabs((ym - y0) * (x1 - x0) - (xm - x0) * (y1 - y0))
+            / sqrt((x1 - x0) * (x1 - x0) + (y1 - y0) * (y1 - y0) + 1e-300);
+        if (dist > tolerance && xs.size() + todo.size() < maxPoints) {
+            todo.push_back(xm);
+        }
+        else {
+            xs.push_back(x1);
+            todo.pop_back();
+        }
+    }
+
+    // xs starts with the first end point and ends with the second, both are skipped
+    for (std::size_t i = 1; i + 1 < xs.size(); ++i) {
+        double x = xs[i];
+        double y = toY(x);
+        double wx = low(segment).x() + x * dx - y * dy;
+        double wy = low(segment).y() + x * dy + y * dx;
+        wire.push_back({dia.scaledVector(wx, wy, 0), fabs(y) / dia.getScale()});
+    }
+}
+
+std::vector<Voronoi::MedialAxisWire> Voronoi::medialAxis(Voronoi::color_type color,
+                                                         double deflection) const
+{
+    std::vector<MedialAxisWire> result;
+    for (auto& edges : wires(color)) {
+        MedialAxisWire wire;
+        for (auto edge : edges) {
+            auto v0 = edge->vertex0();
+            auto v1 = edge->vertex1();
+            if (wire.empty()) {
+                wire.push_back({vd->scaledVector(*v0, 0), vd->distanceToSource(edge, v0)});
+            }
+            if (edge->is_curved() && !vd->isBorderline(edge)) {
+                bool pointFirst = edge->cell()->contains_point();
+                discretizeParabola(
+                    vd->retrievePoint(pointFirst ? edge->cell() : edge->twin()->cell()),
+                    vd->retrieveSegment(pointFirst ? edge->twin()->cell() : edge->cell()),
+                    *v0,
+                    *v1,
+                    deflection,
+                    *vd,
+                    wire);
+            }
+            wire.push_back({vd->scaledVector(*v1, 0), vd->distanceToSource(edge, v1)});
+        }
+        result.push_back(std::move(wire));
+    }
+    return result;
+}
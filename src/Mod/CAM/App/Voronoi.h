@@ -69,16 +69,11 @@ public:
         Base::Vector3d scaledVector(const point_type& p, double z) const;
         Base::Vector3d scaledVector(const vertex_type& v, double z) const;
 
-        using cell_map_type = std::map<intptr_t, int>;
-        using edge_map_type = std::map<intptr_t, int>;
-        using vertex_map_type = std::map<intptr_t, int>;
-
+        // elements are stored in contiguous vectors, the index is the offset into those
         int index(const cell_type* cell) const;
         int index(const edge_type* edge) const;
         int index(const vertex_type* vertex) const;
 
-        void reIndex();
-
         std::vector<point_type> points;
         std::vector<segment_type> segments;
 
@@ -89,19 +84,30 @@ public:
         double angleOfSegment(int i, angle_map_t* angle = nullptr) const;
         bool segmentsAreConnected(int i, int j) const;
 
+        bool isBorderline(const edge_type* edge) const;
+        double distanceToSource(const edge_type* edge, const vertex_type* vertex) const;
+
     private:
         double scale;
-        cell_map_type cell_index;
-        edge_map_type edge_index;
-        vertex_map_type vertex_index;
     };
 
+    // one point of a medial axis polyline and the radius of the inscribed circle at that point
+    struct MedialAxisPoint
+    {
+        Base::Vector3d point;
+        double radius;
+    };
+    using MedialAxisWire = std::vector<MedialAxisPoint>;
+    using EdgeWire = std::vector<const diagram_type::edge_type*>;
+
     void addPoint(const point_type& p);
     void addSegment(const segment_type& p);
     long numPoints() const;
     long numSegments() const;
 
     void construct();
+    // constructs all given diagrams, independent diagrams are processed in parallel
+    static void construct(const std::vector<Voronoi*>& diagrams);
     long numCells() const;
     long numEdges() const;
     long numVertices() const;
@@ -110,6 +116,13 @@ public:
     void colorExterior(color_type color);
     void colorTwins(color_type color);
     void colorColinear(color_type color, double degree);
+    void colorByType(color_type primary, color_type secondary, color_type borderline);
+
+    // chain all finite edges of the given color into wires, each edge oriented along its wire
+    std::vector<EdgeWire> wires(color_type color) const;
+    // same as wires() but with curved edges discretized so no point deviates more than
+    // deflection from the parabola
+    std::vector<MedialAxisWire> medialAxis(color_type color, double deflection) const;
 
     template<typename T>
     T* create(int index)
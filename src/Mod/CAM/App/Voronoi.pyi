@@ -46,6 +46,11 @@ class Voronoi(BaseClass):
         """constructs the voronoi diagram from the input collections"""
         ...
 
+    @staticmethod
+    def constructAll() -> Any:
+        """constructAll([diagrams]) constructs all given voronoi diagrams, using multiple threads"""
+        ...
+
     def colorExterior(self) -> Any:
         """assign given color to all exterior edges and vertices"""
         ...
@@ -58,6 +63,20 @@ class Voronoi(BaseClass):
         """assign given color to all edges sourced by two segments almost in line with each other (optional angle in degrees)"""
         ...
 
+    def colorByType(self) -> Any:
+        """colorByType(primary, secondary, borderline) assign given colors to all primary, secondary and borderline edges"""
+        ...
+
+    @constmethod
+    def getWires(self) -> Any:
+        """getWires(color) return the finite edges of the given color chained into wires, each edge oriented along its wire"""
+        ...
+
+    @constmethod
+    def getMedialAxis(self) -> Any:
+        """getMedialAxis(color, [deflection]) return the edges of the given color as polylines ([points], [radii]), curved edges are discretized within deflection (default 0.01)"""
+        ...
+
     def resetColor(self) -> Any:
         """assign color 0 to all elements with the given color"""
         ...
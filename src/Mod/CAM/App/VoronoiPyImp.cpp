@@ -120,6 +120,27 @@ PyObject* VoronoiPy::construct(PyObject* args)
     return Py_None;
 }
 
+PyObject* VoronoiPy::constructAll(PyObject* args)
+{
+    PyObject* obj = nullptr;
+    if (!PyArg_ParseTuple(args, "O", &obj) || !PySequence_Check(obj)) {
+        throw Py::TypeError("constructAll requires a list of voronoi diagrams");
+    }
+    Py::Sequence list(obj);
+    std::vector<Voronoi*> diagrams;
+    for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+        PyObject* item = (*it).ptr();
+        if (!PyObject_TypeCheck(item, &VoronoiPy::Type)) {
+            throw Py::TypeError("constructAll requires a list of voronoi diagrams");
+        }
+        diagrams.push_back(static_cast<VoronoiPy*>(item)->getVoronoiPtr());
+    }
+    Voronoi::construct(diagrams);
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
 PyObject* VoronoiPy::numCells(PyObject* args) const
 {
     if (!PyArg_ParseTuple(args, "")) {
@@ -284,6 +305,63 @@ PyObject* VoronoiPy::colorColinear(PyObject* args)
     return Py_None;
 }
 
+PyObject* VoronoiPy::colorByType(PyObject* args)
+{
+    Voronoi::color_type primary = 0;
+    Voronoi::color_type secondary = 0;
+    Voronoi::color_type borderline = 0;
+    if (!PyArg_ParseTuple(args, "kkk", &primary, &secondary, &borderline)) {
+        throw Py::RuntimeError(
+            "colorByType requires three integer (primary, secondary, borderline color) arguments");
+    }
+    getVoronoiPtr()->colorByType(primary, secondary, borderline);
+
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+PyObject* VoronoiPy::getWires(PyObject* args) const
+{
+    Voronoi::color_type color = 0;
+    if (!PyArg_ParseTuple(args, "k", &color)) {
+        throw Py::RuntimeError("getWires requires an integer (color) argument");
+    }
+    Voronoi* vo = getVoronoiPtr();
+    Py::List list;
+    for (auto& wire : vo->wires(color)) {
+        Py::List edges;
+        for (auto edge : wire) {
+            edges.append(Py::asObject(new VoronoiEdgePy(new VoronoiEdge(vo->vd, edge))));
+        }
+        list.append(edges);
+    }
+    return Py::new_reference_to(list);
+}
+
+PyObject* VoronoiPy::getMedialAxis(PyObject* args) const
+{
+    Voronoi::color_type color = 0;
+    double deflection = 0.01;
+    if (!PyArg_ParseTuple(args, "k|d", &color, &deflection)) {
+        throw Py::RuntimeError("getMedialAxis requires an integer (color) and optionally a "
+                               "deflection argument (default 0.01)");
+    }
+    if (deflection <= 0) {
+        throw Py::ValueError("deflection must be positive");
+    }
+    Py::List list;
+    for (auto& wire : getVoronoiPtr()->medialAxis(color, deflection)) {
+        Py::List points;
+        Py::List radii;
+        for (auto& pt : wire) {
+            points.append(Py::asObject(new Base::VectorPy(new Base::Vector3d(pt.point))));
+            radii.append(Py::Float(pt.radius));
+        }
+        list.append(Py::TupleN(points, radii));
+    }
+    return Py::new_reference_to(list);
+}
+
 PyObject* VoronoiPy::resetColor(PyObject* args)
 {
     Voronoi::color_type color = 0;
@@ -134,3 +134,21 @@ G0 Z0.500000
         path = Path.Path(commands)
 
         self.assertEqual(path.Length, 2)
+
+    def test51(self):
+        """Test Path.Length and BoundBox follow command edits"""
+        path = Path.Path([Path.Command("G1", {"X": 1}), Path.Command("G1", {"Y": 1})])
+        self.assertEqual(path.Length, 2)
+        self.assertEqual(path.BoundBox.XMax, 1)
+
+        path.addCommands(Path.Command("G1", {"X": 3}))
+        self.assertEqual(path.Length, 4)
+        self.assertEqual(path.BoundBox.XMax, 3)
+
+        path.insertCommand(Path.Command("G1", {"Y": 2}), 1)
+        self.assertEqual(path.Length, 6)
+        self.assertEqual(path.BoundBox.YMax, 2)
+
+        path.deleteCommand(1)
+        self.assertEqual(path.Length, 4)
+        self.assertEqual(path.BoundBox.YMax, 1)
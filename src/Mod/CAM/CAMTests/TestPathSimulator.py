@@ -0,0 +1,122 @@
+# -*- coding: utf-8 -*-
+# ***************************************************************************
+# *   Copyright (c) 2026 FreeCAD Project Association                        *
+# *                                                                         *
+# *   This program is free software; you can redistribute it and/or modify  *
+# *   it under the terms of the GNU Lesser General Public License (LGPL)    *
+# *   as published by the Free Software Foundation; either version 2 of     *
+# *   the License, or (at your option) any later version.                   *
+# *   for detail see the LICENCE text file.                                 *
+# *                                                                         *
+# *   This program is distributed in the hope that it will be useful,       *
+# *   but WITHOUT ANY WARRANTY; without even the implied warranty of        *
+# *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the         *
+# *   GNU Library General Public License for more details.                  *
+# *                                                                         *
+# *   You should have received a copy of the GNU Library General Public     *
+# *   License along with this program; if not, write to the Free Software   *
+# *   Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  *
+# *   USA                                                                   *
+# *                                                                         *
+# ***************************************************************************
+
+import FreeCAD
+import Part
+import Path
+import PathSimulator
+
+from CAMTests.PathTestUtils import PathTestBase
+
+
+def command(name, **params):
+    return Path.Command(name, params)
+
+
+class TestPathSimulator(PathTestBase):
+    """Test the headless toolpath simulation of PathSimulator.PathSim."""
+
+    def setUp(self):
+        self.stock = Part.makeBox(40, 30, 10)
+        self.tool = Part.makeCylinder(2, 20)
+        self.start = FreeCAD.Placement(FreeCAD.Vector(0, 0, 20), FreeCAD.Rotation())
+        # level, ramp and arc moves crossing the whole stock
+        self.toolpath = Path.Path(
+            [
+                command("G0", X=-5, Y=5, Z=20),
+                command("G1", X=-5, Y=5, Z=7),
+                command("G1", X=45, Y=5, Z=7),
+                command("G1", X=45, Y=15, Z=4),
+                command("G1", X=-5, Y=25, Z=6),
+                command("G2", X=35, Y=25, Z=6, I=20, J=0),
+                command("G3", X=5, Y=15, Z=5, I=-15, J=-5),
+                command("G0", X=5, Y=15, Z=20),
+            ]
+        )
+
+    def simulation(self):
+        sim = PathSimulator.PathSim()
+        sim.BeginSimulation(self.stock, 0.5)
+        sim.SetToolShape(self.tool, 0.5)
+        return sim
+
+    def test00(self):
+        """Applying a toolpath gives the same stock as applying its commands one by one."""
+        single = self.simulation()
+        pos = self.start
+        for cmd in self.toolpath.Commands:
+            pos = single.ApplyCommand(pos, cmd)
+
+        bulk = self.simulation()
+        end = bulk.ApplyToolpath(self.start, self.toolpath)
+
+        self.assertCoincide(end.Base, pos.Base)
+        singleVolumes = single.GetRemovedVolumes()
+        bulkVolumes = bulk.GetRemovedVolumes()
+        self.assertEqual(len(bulkVolumes), len(self.toolpath.Commands))
+        self.assertEqual(len(bulkVolumes), len(singleVolumes))
+        for a, b in zip(bulkVolumes, singleVolumes):
+            self.assertRoughly(a, b, 1e-6)
+        self.assertTrue(sum(bulkVolumes) > 0)
+
+        target = Part.makeBox(40, 30, 1)
+        singlePoints, _ = single.GetDeviation(target)
+        bulkPoints, _ = bulk.GetDeviation(target)
+        self.assertEqual(len(bulkPoints), len(singlePoints))
+        for a, b in zip(bulkPoints, singlePoints):
+            self.assertCoincide(a, b)
+
+    def test10(self):
+        """The deviation is the height of the stock above the top of the target."""
+        sim = self.simulation()
+        target = Part.makeBox(40, 30, 5)
+
+        points, deviations = sim.GetDeviation(target)
+        # one sample per cell, the last row and column of cells reach past the stock
+        self.assertEqual(len(points), 81 * 61)
+        self.assertEqual(len(deviations), len(points))
+        for pt, deviation in zip(points, deviations):
+            self.assertRoughly(pt.z, 10, 1e-6)
+            if pt.x < 40 and pt.y < 30:
+                self.assertRoughly(deviation, 5, 1e-6)
+            else:
+                self.assertRoughly(deviation, 10, 1e-6)
+
+        # a level cut below the target top gouges it
+        sim.ApplyToolpath(
+            self.start,
+            Path.Path([command("G1", X=-5, Y=15, Z=4), command("G1", X=45, Y=15, Z=4)]),
+        )
+        points, deviations = sim.GetDeviation(target)
+        for pt, deviation in zip(points, deviations):
+            if pt.x > 40 or pt.y > 30:
+                continue
+            if abs(pt.y - 15) < 1:
+                self.assertRoughly(deviation, -1, 1e-6)
+            elif abs(pt.y - 15) > 3:
+                self.assertRoughly(deviation, 5, 1e-6)
+
+        # where there is no target all of the stock is left over
+        points, deviations = sim.GetDeviation(Part.makeBox(20, 30, 5))
+        for pt, deviation in zip(points, deviations):
+            if pt.x > 21 and abs(pt.y - 15) > 3:
+                self.assertRoughly(deviation, 10, 1e-6)
@@ -188,3 +188,28 @@ class TestPathVoronoi(PathTestUtils.PathTestBase):
         )
         self.assertRoughly(e.valueAt(e.FirstParameter).z, 2.37)
         self.assertRoughly(e.valueAt(e.LastParameter).z, 5.14)
+
+    def test70(self):
+        """Check getWires chains edges of a color"""
+
+        wires = vd.getWires(0)
+        self.assertNotEqual(len(wires), 0)
+        edges = [e for w in wires for e in w]
+        self.assertTrue(all(e.Color == 0 and e.isFinite() for e in edges))
+        for w in wires:
+            for e0, e1 in zip(w, w[1:]):
+                self.assertEqual(e0.Vertices[1], e1.Vertices[0])
+
+    def test71(self):
+        """Check getMedialAxis returns polylines with a radius per point"""
+
+        wires = vd.getWires(0)
+        axis = vd.getMedialAxis(0, 0.001)
+        self.assertEqual(len(axis), len(wires))
+        for w, (points, radii) in zip(wires, axis):
+            self.assertEqual(len(points), len(radii))
+            self.assertGreaterEqual(len(points), len(w) + 1)
+            self.assertRoughly(radii[0], w[0].getDistances()[0])
+            self.assertRoughly(radii[-1], w[-1].getDistances()[1])
+            self.assertRoughly(points[0].distanceToPoint(w[0].Vertices[0].toPoint()), 0)
+            self.assertRoughly(points[-1].distanceToPoint(w[-1].Vertices[1].toPoint()), 0)
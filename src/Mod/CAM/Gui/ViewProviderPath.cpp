@@ -20,7 +20,13 @@
  *                                                                         *
  ***************************************************************************/
 
+#include <algorithm>
+#include <deque>
+#include <exception>
 #include <limits>
+#include <QFuture>
+#include <QThreadPool>
+#include <QtConcurrentRun>
 #include <boost/algorithm/string/replace.hpp>
 
 #include <Inventor/SbVec3f.h>
@@ -37,6 +43,7 @@
 
 #include <App/Application.h>
 #include <App/DocumentObject.h>
+#include <Base/BoundBox.h>
 #include <Base/Parameter.h>
 #include <Base/Stream.h>
 #include <Gui/Application.h>
@@ -526,6 +533,111 @@ void ViewProviderPath::hideSelection()
     pcArrowSwitch->whichChild = -1;
 }
 
+namespace
+{
+
+// Upper bound of the points folded into a single decimated segment, it keeps the
+// tolerance check of each new point from degenerating for very long arcs.
+const std::size_t DecimateMaxRun = 256;
+
+// Number of edges buffered while walking the path before they are decimated as one task
+const std::size_t DecimateChunkEdges = 4096;
+
+/// Result of decimating a consecutive range of path edges
+struct DecimatedChunk
+{
+    std::vector<Base::Vector3d> points;
+    // color of the segment ending at points[i+1]
+    std::vector<int> colors;
+    // exclusive end index into points of each edge
+    std::vector<int> edgeEnds;
+    std::exception_ptr error;
+};
+
+double squareDistanceToSegment(const Base::Vector3d& pt,
+                               const Base::Vector3d& start,
+                               const Base::Vector3d& end)
+{
+    Base::Vector3d dir = end - start;
+    Base::Vector3d vec = pt - start;
+    double len = dir.Sqr();
+    if (len <= 0.0) {
+        return vec.Sqr();
+    }
+    double t = std::clamp((vec * dir) / len, 0.0, 1.0);
+    return (vec - dir * t).Sqr();
+}
+
+/** Decimates the edges [first, last) of a tessellated path.
+ *
+ * Every point of an edge whose removal keeps all skipped points within \a tolerance of
+ * the simplified segment is dropped, which removes arc interpolation points that are
+ * finer than the requested chordal tolerance. Each edge still holds exactly one movement
+ * command, so that selection and stepping through the commands are not affected. Edges
+ * with mixed colors (drill cycles) are passed through unchanged.
+ */
+void decimateEdges(const std::vector<Base::Vector3d>& points,
+                   const std::vector<int>& colors,
+                   const std::vector<int>& edgeIndices,
+                   std::size_t first,
+                   std::size_t last,
+                   double tolerance,
+                   DecimatedChunk& out)
+{
+    const double tol2 = tolerance * tolerance;
+
+    out.points.push_back(points[first == 0 ? 0 : edgeIndices[first - 1] - 1]);
+
+    std::vector<int> pending;
+    for (std::size_t e = first; e < last; ++e) {
+        int begin = e == 0 ? 0 : edgeIndices[e - 1] - 1;
+        int end = edgeIndices[e];
+        int color = colors[begin];
+        bool uniform = tolerance > 0.0;
+        for (int i = begin + 1; i < end - 1 && uniform; ++i) {
+            uniform = colors[i] == color;
+        }
+
+        if (!uniform) {
+            for (int i = begin + 1; i < end; ++i) {
+                out.points.push_back(points[i]);
+                out.colors.push_back(colors[i - 1]);
+            }
+            out.edgeEnds.push_back(out.points.size());
+            continue;
+        }
+
+        int anchor = begin;
+        auto accepts = [&](int index) {
+            if (pending.size() >= DecimateMaxRun) {
+                return false;
+            }
+            for (int p : pending) {
+                if (squareDistanceToSegment(points[p], points[anchor], points[index]) > tol2) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        for (int i = begin + 1; i < end; ++i) {
+            if (!pending.empty() && !accepts(i)) {
+                anchor = pending.back();
+                out.points.push_back(points[anchor]);
+                out.colors.push_back(color);
+                pending.clear();
+            }
+            pending.push_back(i);
+        }
+        // the last point of the edge is always kept
+        out.points.push_back(points[end - 1]);
+        out.colors.push_back(color);
+        pending.clear();
+        out.edgeEnds.push_back(out.points.size());
+    }
+}
+
+}  // namespace
+
 class VisualPathSegmentVisitor: public PathSegmentVisitor
 {
 public:
@@ -533,32 +645,52 @@ public:
                              SoCoordinate3* pcLineCoords_,
                              SoCoordinate3* pcMarkerCoords_,
                              std::vector<int>& command2Edge_,
-                             std::deque<int>& edge2Command_,
-                             std::deque<int>& edgeIndices_,
-                             std::vector<int>& colorindex_,
-                             std::deque<Base::Vector3d>& points_,
-                             std::deque<Base::Vector3d>& markers_)
+                             std::vector<int>& edge2Command_,
+                             std::vector<Base::Vector3d>& markers_,
+                             std::deque<DecimatedChunk>& chunks_,
+                             double tolerance_)
         : pcLineCoords(pcLineCoords_)
         , pcMarkerCoords(pcMarkerCoords_)
         , command2Edge(command2Edge_)
         , edge2Command(edge2Command_)
-        , edgeIndices(edgeIndices_)
-        , colorindex(colorindex_)
-        , points(points_)
         , markers(markers_)
+        , chunks(chunks_)
+        , tolerance(tolerance_)
     {
         pcLineCoords->point.deleteValues(0);
         pcMarkerCoords->point.deleteValues(0);
 
         command2Edge.clear();
         edge2Command.clear();
-        edgeIndices.clear();
-
-        colorindex.clear();
+        chunks.clear();
 
         command2Edge.resize(tp.getSize(), -1);
     }
 
+    ~VisualPathSegmentVisitor() override
+    {
+        // the chunks must outlive their tasks, also when walking the path failed
+        for (auto& task : tasks) {
+            task.waitForFinished();
+        }
+    }
+
+    /// Decimates the remaining edges and waits for all chunks
+    void finish()
+    {
+        if (!edgeIndices.empty()) {
+            flush(tasks.empty());
+        }
+        for (auto& task : tasks) {
+            task.waitForFinished();
+        }
+        for (const auto& chunk : chunks) {
+            if (chunk.error) {
+                std::rethrow_exception(chunk.error);
+            }
+        }
+    }
+
     void setup(const Base::Vector3d& last) override
     {
         points.push_back(last);
@@ -655,12 +787,19 @@ private:
     SoCoordinate3* pcMarkerCoords;
 
     std::vector<int>& command2Edge;
-    std::deque<int>& edge2Command;
-    std::deque<int>& edgeIndices;
+    std::vector<int>& edge2Command;
+    std::vector<Base::Vector3d>& markers;
+
+    // tessellated edges not yet handed over to be decimated, they start with the last
+    // point of the previous edge
+    std::vector<int> edgeIndices;
+    std::vector<int> colorindex;
+    std::vector<Base::Vector3d> points;
 
-    std::vector<int>& colorindex;
-    std::deque<Base::Vector3d>& points;
-    std::deque<Base::Vector3d>& markers;
+    std::deque<DecimatedChunk>& chunks;
+    std::vector<QFuture<void>> tasks;
+    std::size_t finishedTasks = 0;
+    double tolerance;
 
     virtual void
     gx(int id, const Base::Vector3d* next, const std::deque<Base::Vector3d>& pts, int color)
@@ -681,9 +820,48 @@ private:
 
     void pushCommand(int id)
     {
-        command2Edge[id] = edgeIndices.size();
+        command2Edge[id] = edge2Command.size();
         edgeIndices.push_back(points.size());
         edge2Command.push_back(id);
+        if (edgeIndices.size() >= DecimateChunkEdges) {
+            flush(false);
+        }
+    }
+
+    void flush(bool inCurrentThread)
+    {
+        // the deque keeps the chunks in place while more are added
+        chunks.emplace_back();
+        DecimatedChunk& chunk = chunks.back();
+        Base::Vector3d last = points.back();
+        auto decimate = [&chunk,
+                         tolerance = tolerance,
+                         points = std::move(points),
+                         colors = std::move(colorindex),
+                         edges = std::move(edgeIndices)]() {
+            try {
+                decimateEdges(points, colors, edges, 0, edges.size(), tolerance, chunk);
+            }
+            catch (...) {
+                chunk.error = std::current_exception();
+            }
+        };
+        points.clear();
+        colorindex.clear();
+        edgeIndices.clear();
+        points.push_back(last);
+
+        if (inCurrentThread) {
+            decimate();
+            return;
+        }
+        tasks.push_back(QtConcurrent::run(std::move(decimate)));
+
+        // do not buffer more edges than the pool can keep up with
+        std::size_t limit = 2 * std::max(1, QThreadPool::globalInstance()->maxThreadCount());
+        while (tasks.size() - finishedTasks > limit) {
+            tasks[finishedTasks++].waitForFinished();
+        }
     }
 };
 
@@ -700,36 +878,16 @@ void ViewProviderPath::updateVisual(bool rebuild)
         Path::Feature* pcPathObj = static_cast<Path::Feature*>(pcObject);
         const Toolpath& tp = pcPathObj->Path.getValue();
 
-        std::deque<Base::Vector3d> points;
-        std::deque<Base::Vector3d> markers;
-
-        VisualPathSegmentVisitor collect(tp,
-                                         pcLineCoords,
-                                         pcMarkerCoords,
-                                         command2Edge,
-                                         edge2Command,
-                                         edgeIndices,
-                                         colorindex,
-                                         points,
-                                         markers);
-
-        PathSegmentWalker segments(tp);
-        segments.walk(collect, StartPosition.getValue());
-
+        std::vector<Base::Vector3d> markers;
+        decimate(tp, markers);
 
         if (!edgeIndices.empty()) {
-            pcLineCoords->point.setNum(points.size());
-            SbVec3f* verts = pcLineCoords->point.startEditing();
-            int i = 0;
-            for (const auto& pt : points) {
-                verts[i++].setValue(pt.x, pt.y, pt.z);
-            }
-            pcLineCoords->point.finishEditing();
-
             pcMarkerCoords->point.setNum(markers.size());
-            for (unsigned int i = 0; i < markers.size(); i++) {
-                pcMarkerCoords->point.set1Value(i, markers[i].x, markers[i].y, markers[i].z);
+            SbVec3f* verts = pcMarkerCoords->point.startEditing();
+            for (std::size_t i = 0; i < markers.size(); ++i) {
+                verts[i].setValue(markers[i].x, markers[i].y, markers[i].z);
             }
+            pcMarkerCoords->point.finishEditing();
 
             recomputeBoundingBox();
         }
@@ -764,24 +922,90 @@ void ViewProviderPath::updateVisual(bool rebuild)
     coordStart = edgeStart == 0 ? 0 : (edgeIndices[edgeStart - 1] - 1);
     coordEnd = edgeIndices[edgeEnd - 1];
 
-    // count = coord indices + index separators
-    int count = coordEnd - coordStart + 2 * (edgeEnd - edgeStart - 1) + 1;
+    // the line indices of all edges are built on rebuild, so that animating StartIndex and
+    // ShowCount only copies the visible slice
+    int offset = edgeOffsets[edgeStart];
+    int count = edgeOffsets[edgeEnd] - offset;
+    pcLines->coordIndex.setValues(0, count, coordIndexCache.data() + offset);
+
+    NormalColor.touch();
+}
+
+void ViewProviderPath::decimate(const Toolpath& tp, std::vector<Base::Vector3d>& markers)
+{
+    edgeIndices.clear();
+    edgeOffsets.clear();
+    coordIndexCache.clear();
+    colorindex.clear();
+
+    // The tolerance is relative to the size of the path, so that the dropped detail stays
+    // well below a pixel when the whole path is in view.
+    ParameterGrp::handle hGrp =
+        App::GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Mod/CAM");
+    double tolerance = 0.0;
+    double ratio = hGrp->GetFloat("DefaultPathDecimation", 1e-5);
+    if (ratio > 0.0) {
+        Base::BoundBox3d bbox = tp.getBoundBox();
+        bbox.Add(StartPosition.getValue());
+        tolerance = bbox.CalcDiagonalLength() * ratio;
+    }
 
-    pcLines->coordIndex.setNum(count);
-    int32_t* idx = pcLines->coordIndex.startEditing();
-    i = 0;
-    int start = coordStart;
-    for (int e = edgeStart; e != edgeEnd; ++e) {
-        for (int end = edgeIndices[e]; start < end; ++start) {
-            idx[i++] = start;
+    // the edges are decimated in chunks on the global thread pool while walking the path
+    std::deque<DecimatedChunk> chunks;
+    VisualPathSegmentVisitor collect(tp,
+                                     pcLineCoords,
+                                     pcMarkerCoords,
+                                     command2Edge,
+                                     edge2Command,
+                                     markers,
+                                     chunks,
+                                     tolerance);
+
+    PathSegmentWalker segments(tp);
+    segments.walk(collect, StartPosition.getValue());
+    collect.finish();
+
+    if (chunks.empty()) {
+        return;
+    }
+
+    // stitch the chunks, consecutive chunks share their boundary point
+    std::size_t total = 1;
+    for (const auto& chunk : chunks) {
+        total += chunk.points.size() - 1;
+    }
+    pcLineCoords->point.setNum(total);
+    SbVec3f* verts = pcLineCoords->point.startEditing();
+    colorindex.reserve(total - 1);
+
+    int base = 0;
+    for (std::size_t c = 0; c < chunks.size(); ++c) {
+        const auto& chunk = chunks[c];
+        for (std::size_t i = c == 0 ? 0 : 1; i < chunk.points.size(); ++i) {
+            const auto& pt = chunk.points[i];
+            verts[base + i].setValue(pt.x, pt.y, pt.z);
+        }
+        colorindex.insert(colorindex.end(), chunk.colors.begin(), chunk.colors.end());
+        for (int end : chunk.edgeEnds) {
+            edgeIndices.push_back(base + end);
         }
-        idx[i++] = -1;
+        base += chunk.points.size() - 1;
+    }
+    pcLineCoords->point.finishEditing();
+
+    // line indices of all edges, each edge starts at the last point of its predecessor
+    edgeOffsets.reserve(edgeIndices.size() + 1);
+    coordIndexCache.reserve(total + 2 * edgeIndices.size());
+    int start = 0;
+    for (int end : edgeIndices) {
+        edgeOffsets.push_back(coordIndexCache.size());
+        for (; start < end; ++start) {
+            coordIndexCache.push_back(start);
+        }
+        coordIndexCache.push_back(-1);
         --start;
     }
-    pcLines->coordIndex.finishEditing();
-    assert(i == count);
-
-    NormalColor.touch();
+    edgeOffsets.push_back(coordIndexCache.size());
 }
 
 void ViewProviderPath::recomputeBoundingBox()
@@ -39,6 +39,11 @@ class SoMaterialBinding;
 class SoTransform;
 class SoSwitch;
 
+namespace Path
+{
+class Toolpath;
+}
+
 namespace PathGui
 {
 
@@ -91,6 +96,9 @@ protected:
     void onChanged(const App::Property* prop) override;
     unsigned long getBoundColor() const override;
 
+    /// Tessellates the path and simplifies its edges into the line coordinates
+    void decimate(const Path::Toolpath& tp, std::vector<Base::Vector3d>& markers);
+
     SoCoordinate3* pcLineCoords;
     SoCoordinate3* pcMarkerCoords;
     SoDrawStyle* pcDrawStyle;
@@ -105,8 +113,11 @@ protected:
     SoTransform* pcArrowTransform;
 
     std::vector<int> command2Edge;
-    std::deque<int> edge2Command;
-    std::deque<int> edgeIndices;
+    std::vector<int> edge2Command;
+    std::vector<int> edgeIndices;
+    // line indices of all edges and the offset of each edge into them
+    std::vector<int32_t> coordIndexCache;
+    std::vector<int> edgeOffsets;
 
     mutable int pt0Index;
     bool blockPropertyChange;
@@ -51,65 +51,6 @@ else:
 translate = FreeCAD.Qt.translate
 
 
-def _collectVoronoiWires(vd):
-    edges = [e for e in vd.Edges if e.Color == PRIMARY]
-    vertex = {}
-    for e in edges:
-        for v in e.Vertices:
-            i = v.Index
-            j = vertex.get(i, [])
-            j.append(e)
-            vertex[i] = j
-
-    # knots are the start and end points of a wire
-    knots = [i for i in vertex if len(vertex[i]) == 1]
-    knots.extend([i for i in vertex if len(vertex[i]) > 2])
-    if len(knots) == 0:
-        for i in vertex:
-            if len(vertex[i]) > 0:
-                knots.append(i)
-                break
-
-    def consume(v, edge):
-        vertex[v] = [e for e in vertex[v] if e.Index != edge.Index]
-        return len(vertex[v]) == 0
-
-    def traverse(vStart, edge, edges):
-        if vStart == edge.Vertices[0].Index:
-            vEnd = edge.Vertices[1].Index
-            edges.append(edge)
-        else:
-            vEnd = edge.Vertices[0].Index
-            edges.append(edge.Twin)
-
-        consume(vStart, edge)
-        if consume(vEnd, edge):
-            return None
-        return vEnd
-
-    wires = []
-    while knots:
-        we = []
-        vFirst = knots[0]
-        vStart = vFirst
-        vLast = vFirst
-        if len(vertex[vStart]):
-            while vStart is not None:
-                vLast = vStart
-                edges = vertex[vStart]
-                if len(edges) > 0:
-                    edge = edges[0]
-                    vStart = traverse(vStart, edge, we)
-                else:
-                    vStart = None
-            wires.append(we)
-        if len(vertex[vFirst]) == 0:
-            knots = [v for v in knots if v != vFirst]
-        if len(vertex[vLast]) == 0:
-            knots = [v for v in knots if v != vLast]
-    return wires
-
-
 def _sortVoronoiWires(wires, start=FreeCAD.Vector(0, 0, 0)):
     def closestTo(start, point):
         p = None
@@ -396,21 +337,19 @@ class ObjectVcarve(PathEngraveBase.ObjectOp):
                 for i in range(len(ptv) - 1):
                     vd.addSegment(ptv[i], ptv[i + 1])
 
+        diagrams = []
         for f in faces:
-            voronoiWires = []
             vd = Path.Voronoi.Diagram()
             insert_many_wires(vd, f.Wires)
+            diagrams.append(vd)
+
+        # the faces are independent, construct their diagrams in parallel
+        Path.Voronoi.Diagram.constructAll(diagrams)
 
-            vd.construct()
+        for f, vd in zip(faces, diagrams):
+            voronoiWires = []
 
-            for e in vd.Edges:
-                if e.isPrimary():
-                    if e.isBorderline():
-                        e.Color = BORDERLINE
-                    else:
-                        e.Color = PRIMARY
-                else:
-                    e.Color = SECONDARY
+            vd.colorByType(PRIMARY, SECONDARY, BORDERLINE)
 
             # filter our colinear edged so there are fewer ones
             # to iterate over in colorExterior which is slow
@@ -424,7 +363,7 @@ class ObjectVcarve(PathEngraveBase.ObjectOp):
             # keep it here to be safe
             vd.colorTwins(TWIN)
 
-            wires = _collectVoronoiWires(vd)
+            wires = vd.getWires(PRIMARY)
             wires = _sortVoronoiWires(wires)
             voronoiWires.extend(wires)
 
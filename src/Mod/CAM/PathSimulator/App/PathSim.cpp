@@ -45,6 +45,7 @@ void PathSim::BeginSimulation(Part::TopoShape* stock, float resolution)
                                        bbox.LengthY(),
                                        bbox.LengthZ(),
                                        resolution);
+    m_removedVolumes.clear();
 }
 
 void PathSim::SetToolShape(const TopoDS_Shape& toolShape, float resolution)
@@ -57,24 +58,63 @@ Base::Placement* PathSim::ApplyCommand(Base::Placement* pos, Command* cmd)
     Point3D fromPos(*pos);
     Point3D toPos(*pos);
     toPos.UpdateCmd(*cmd);
+    double removed = 0;
     if (m_tool) {
         if (cmd->Name == "G0" || cmd->Name == "G1") {
-            m_stock->ApplyLinearTool(fromPos, toPos, *m_tool);
+            removed = m_stock->ApplyLinearTool(fromPos, toPos, *m_tool);
         }
         else if (cmd->Name == "G2") {
             Vector3d vcent = cmd->getCenter();
             Point3D cent(vcent);
-            m_stock->ApplyCircularTool(fromPos, toPos, cent, *m_tool, false);
+            removed = m_stock->ApplyCircularTool(fromPos, toPos, cent, *m_tool, false);
         }
         else if (cmd->Name == "G3") {
             Vector3d vcent = cmd->getCenter();
             Point3D cent(vcent);
-            m_stock->ApplyCircularTool(fromPos, toPos, cent, *m_tool, true);
+            removed = m_stock->ApplyCircularTool(fromPos, toPos, cent, *m_tool, true);
         }
     }
+    m_removedVolumes.push_back(removed);
 
     Base::Placement* plc = new Base::Placement();
     Vector3d vec(toPos.x, toPos.y, toPos.z);
     plc->setPosition(vec);
     return plc;
 }
+
+Base::Placement PathSim::ApplyToolpath(const Base::Placement& pos, const Toolpath& toolpath)
+{
+    // resolve the positions first, the stock is then machined in parallel
+    std::vector<cStockMove> moves;
+    moves.reserve(toolpath.getSize());
+    Base::Placement start(pos);
+    Point3D fromPos(start);
+    for (Command* cmd : toolpath.getCommands()) {
+        cStockMove move;
+        move.from = fromPos;
+        move.to = fromPos;
+        move.to.UpdateCmd(*cmd);
+        if (cmd->Name == "G0" || cmd->Name == "G1") {
+            move.type = cStockMove::Linear;
+        }
+        else if (cmd->Name == "G2" || cmd->Name == "G3") {
+            Vector3d vcent = cmd->getCenter();
+            move.center = Point3D(vcent);
+            move.type = cmd->Name == "G2" ? cStockMove::Arc : cStockMove::ArcCCW;
+        }
+        fromPos = move.to;
+        moves.push_back(move);
+    }
+
+    if (m_tool) {
+        std::vector<double> removed = m_stock->ApplyMoves(moves, *m_tool);
+        m_removedVolumes.insert(m_removedVolumes.end(), removed.begin(), removed.end());
+    }
+    else {
+        m_removedVolumes.resize(m_removedVolumes.size() + moves.size());
+    }
+
+    Base::Placement end;
+    end.setPosition(Vector3d(fromPos.x, fromPos.y, fromPos.z));
+    return end;
+}
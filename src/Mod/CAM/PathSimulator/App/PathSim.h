@@ -24,9 +24,11 @@
 #define PATHSIMULATOR_PathSim_H
 
 #include <memory>
+#include <vector>
 #include <TopoDS_Shape.hxx>
 
 #include <Mod/CAM/App/Command.h>
+#include <Mod/CAM/App/Path.h>
 #include <Mod/Part/App/TopoShape.h>
 #include <Mod/CAM/PathGlobal.h>
 
@@ -51,10 +53,14 @@ public:
     void BeginSimulation(Part::TopoShape* stock, float resolution);
     void SetToolShape(const TopoDS_Shape& toolShape, float resolution);
     Base::Placement* ApplyCommand(Base::Placement* pos, Command* cmd);
+    // applies all commands of the toolpath starting from pos, returns the final position
+    Base::Placement ApplyToolpath(const Base::Placement& pos, const Toolpath& toolpath);
 
 public:
     std::unique_ptr<cStock> m_stock;
     std::unique_ptr<cSimTool> m_tool;
+    // stock volume removed by each command applied since the simulation began
+    std::vector<double> m_removedVolumes;
 };
 
 }  // namespace PathSimulator
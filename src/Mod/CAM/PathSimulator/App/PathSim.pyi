@@ -47,5 +47,29 @@ class PathSim(BaseClass):
 
                   Apply a single path command on the stock starting from placement."""
         ...
+
+    def ApplyToolpath(self, **kwargs) -> Any:
+        """
+        ApplyToolpath(placement, toolpath):
+
+                  Apply all commands of a toolpath on the stock starting from placement.
+                  Return the placement at the end of the toolpath."""
+        ...
+
+    def GetDeviation(self) -> Any:
+        """
+        GetDeviation(shape):
+
+                  Compare the stock to the target shape. Return a tuple of the stock surface points
+                  and their vertical distances above the top of the shape, negative where it was
+                  gouged."""
+        ...
+
+    def GetRemovedVolumes(self) -> Any:
+        """
+        GetRemovedVolumes():
+
+                  Return the stock volume removed by each command applied since the simulation began."""
+        ...
     Tool: Final[Any]
     """Return current simulation tool."""
@@ -23,9 +23,11 @@
 
 #include <Base/PlacementPy.h>
 #include <Base/PyWrapParseTupleAndKeywords.h>
+#include <Base/VectorPy.h>
 
 #include <Mod/Mesh/App/MeshPy.h>
 #include <Mod/CAM/App/CommandPy.h>
+#include <Mod/CAM/App/PathPy.h>
 #include <Mod/Part/App/TopoShapePy.h>
 
 #include "PathSim.h"
@@ -139,6 +141,69 @@ PyObject* PathSimPy::ApplyCommand(PyObject* args, PyObject* kwds)
     return newposPy;
 }
 
+PyObject* PathSimPy::ApplyToolpath(PyObject* args, PyObject* kwds)
+{
+    static const std::array<const char*, 3> kwlist {"position", "toolpath", nullptr};
+    PyObject* pObjPlace;
+    PyObject* pObjPath;
+    if (!Base::Wrapped_ParseTupleAndKeywords(args,
+                                             kwds,
+                                             "O!O!",
+                                             kwlist,
+                                             &(Base::PlacementPy::Type),
+                                             &pObjPlace,
+                                             &(Path::PathPy::Type),
+                                             &pObjPath)) {
+        return nullptr;
+    }
+    PathSim* sim = getPathSimPtr();
+    if (!sim->m_stock) {
+        PyErr_SetString(PyExc_RuntimeError, "Simulation has no stock object");
+        return nullptr;
+    }
+    Base::Placement* pos = static_cast<Base::PlacementPy*>(pObjPlace)->getPlacementPtr();
+    Path::Toolpath* toolpath = static_cast<Path::PathPy*>(pObjPath)->getToolpathPtr();
+    return new Base::PlacementPy(new Base::Placement(sim->ApplyToolpath(*pos, *toolpath)));
+}
+
+PyObject* PathSimPy::GetDeviation(PyObject* args)
+{
+    PyObject* pObjTarget;
+    if (!PyArg_ParseTuple(args, "O!", &(Part::TopoShapePy::Type), &pObjTarget)) {
+        return nullptr;
+    }
+    cStock* stock = getPathSimPtr()->m_stock.get();
+    if (!stock) {
+        PyErr_SetString(PyExc_RuntimeError, "Simulation has no stock object");
+        return nullptr;
+    }
+    const TopoDS_Shape& target =
+        static_cast<Part::TopoShapePy*>(pObjTarget)->getTopoShapePtr()->getShape();
+    std::vector<Base::Vector3d> points;
+    std::vector<float> deviations;
+    stock->GetDeviation(target, points, deviations);
+
+    Py::List pyPoints;
+    Py::List pyDeviations;
+    for (size_t i = 0; i < points.size(); i++) {
+        pyPoints.append(Py::asObject(new Base::VectorPy(points[i])));
+        pyDeviations.append(Py::Float(deviations[i]));
+    }
+    return Py::new_reference_to(Py::TupleN(pyPoints, pyDeviations));
+}
+
+PyObject* PathSimPy::GetRemovedVolumes(PyObject* args)
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return nullptr;
+    }
+    Py::List volumes;
+    for (double volume : getPathSimPtr()->m_removedVolumes) {
+        volumes.append(Py::Float(volume));
+    }
+    return Py::new_reference_to(volumes);
+}
+
 Py::Object PathSimPy::getTool() const
 {
     // return Py::Object();
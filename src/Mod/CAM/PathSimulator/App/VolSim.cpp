@@ -21,12 +21,18 @@
  ***************************************************************************/
 
 #include <algorithm>
+#include <numeric>
+#include <thread>
 
 
 #include <BRepBndLib.hxx>
 #include <BRepCheck_Analyzer.hxx>
 #include <BRepClass3d_SolidClassifier.hxx>
+#include <gp_Dir.hxx>
+#include <gp_Lin.hxx>
 #include <gp_Pnt.hxx>
+#include <IntCurvesFace_ShapeIntersector.hxx>
+#include <Precision.hxx>
 
 #include "VolSim.h"
 
@@ -508,74 +514,106 @@ void cStock::CreatePocket(float cxf, float cyf, float radf, float height)
     }
 }
 
-void cStock::ApplyLinearTool(Point3D& p1, Point3D& p2, cSimTool& tool)
+// Limits the steps [from, to) of a walk over x = x0 + i * dx, i = 0..count-1, to the ones that may
+// land in the columns xBegin up to xEnd. Cells are found by truncation, so one column of margin is
+// kept on either side.
+static void ClipWalk(float x0, float dx, int count, int xBegin, int xEnd, int& from, int& to)
+{
+    float lo = xBegin - 1 - x0;
+    float hi = xEnd + 1 - x0;
+    if (fabs(dx) < SIM_EPSILON) {
+        from = 0;
+        to = (lo <= 0 && hi > 0) ? count : 0;
+        return;
+    }
+    float i1 = lo / dx;
+    float i2 = hi / dx;
+    if (i1 > i2) {
+        std::swap(i1, i2);
+    }
+    from = (int)std::clamp(floorf(i1), 0.0f, (float)count);
+    to = (int)std::clamp(ceilf(i2) + 1, 0.0f, (float)count);
+}
+
+double cStock::ApplyLinearTool(Point3D& p1, Point3D& p2, cSimTool& tool, int xBegin, int xEnd)
 {
     // translate coordinates
     Point3D pi1 = ToInner(p1);
     Point3D pi2 = ToInner(p2);
-    float rad = tool.radius;
-    rad /= m_res;
-    float cupAngle = 180;
+    xBegin = std::max(xBegin, 0);
+    xEnd = std::min(xEnd, m_x);
 
-    // strait motion
-    float perpDirX = 1;
-    float perpDirY = 0;
+    // level and vertical moves are swept exactly
+    if (fabs(pi2.z - pi1.z) < SIM_EPSILON) {
+        return ApplyLevelTool(pi1, pi2, pi1.z, tool, xBegin, xEnd);
+    }
     cLineSegment path(pi1, pi2);
-    if (path.lenXY > SIM_EPSILON)  // only if moving along xy
-    {
-        perpDirX = -path.pDirXY.y;
-        perpDirY = path.pDirXY.x;
-        Point3D start(perpDirX * rad + pi1.x, perpDirY * rad + pi1.y, pi1.z);
-        Point3D mainWay = path.pDir * SIM_WALK_RES;
-        Point3D sideWay(-perpDirX * SIM_WALK_RES, -perpDirY * SIM_WALK_RES, 0);
-        int lenSteps = (int)(path.len / SIM_WALK_RES) + 1;
-        int radSteps = (int)(rad * 2 / SIM_WALK_RES) + 1;
-        float zstep = (pi2.z - pi1.z) / radSteps;
-        float tstep = 2.0 / radSteps;
-        float t = -1;
-        for (int j = 0; j < radSteps; j++) {
-            float z = pi1.z + tool.GetToolProfileAt(t);
-            Point3D p = start;
-            for (int i = 0; i < lenSteps; i++) {
-                int x = (int)p.x;
-                int y = (int)p.y;
-                if (x >= 0 && y >= 0 && x < m_x && y < m_y) {
-                    if (m_stock[x][y] > z) {
-                        m_stock[x][y] = z;
-                    }
-                }
-                p.Add(mainWay);
-                z += zstep;
+    if (!(path.lenXY > SIM_EPSILON)) {
+        return ApplyLevelTool(pi2, pi2, std::min(pi1.z, pi2.z), tool, xBegin, xEnd);
+    }
+
+    // ramp motion
+    double removed = 0;
+    float rad = tool.radius;
+    rad /= m_res;
+    float perpDirX = -path.pDirXY.y;
+    float perpDirY = path.pDirXY.x;
+    Point3D start(perpDirX * rad + pi1.x, perpDirY * rad + pi1.y, pi1.z);
+    Point3D mainWay = path.pDir * SIM_WALK_RES;
+    Point3D sideWay(-perpDirX * SIM_WALK_RES, -perpDirY * SIM_WALK_RES, 0);
+    int lenSteps = (int)(path.len / SIM_WALK_RES) + 1;
+    int radSteps = (int)(rad * 2 / SIM_WALK_RES) + 1;
+    float zstep = (pi2.z - pi1.z) / radSteps;
+    float tstep = 2.0 / radSteps;
+    float t = -1;
+    for (int j = 0; j < radSteps; j++) {
+        // only walk the part of the strand that crosses the band
+        int from, to;
+        ClipWalk(start.x, mainWay.x, lenSteps, xBegin, xEnd, from, to);
+        float z = pi1.z + tool.GetToolProfileAt(t);
+        for (int i = from; i < to; i++) {
+            int x = (int)(start.x + i * mainWay.x);
+            int y = (int)(start.y + i * mainWay.y);
+            if (x >= xBegin && y >= 0 && x < xEnd && y < m_y) {
+                removed += LowerStock(x, y, z + i * zstep);
             }
-            t += tstep;
-            start.Add(sideWay);
         }
-    }
-    else {
-        cupAngle = 360;
+        t += tstep;
+        start.Add(sideWay);
     }
 
     // end cup
     for (float r = 0.5f; r <= rad; r += (float)SIM_WALK_RES) {
+        if (pi2.x + r < xBegin - 1 || pi2.x - r >= xEnd + 1) {
+            continue;
+        }
         Point3D cupCirc(perpDirX * r, perpDirY * r, pi2.z);
         float rotang = 180 * SIM_WALK_RES / (pi * r);
         cupCirc.SetRotationAngle(-rotang);
         float z = pi2.z + tool.GetToolProfileAt(r / rad);
-        for (float a = 0; a < cupAngle; a += rotang) {
+        for (float a = 0; a < 180; a += rotang) {
             int x = (int)(pi2.x + cupCirc.x);
             int y = (int)(pi2.y + cupCirc.y);
-            if (x >= 0 && y >= 0 && x < m_x && y < m_y) {
-                if (m_stock[x][y] > z) {
-                    m_stock[x][y] = z;
-                }
+            if (x >= xBegin && y >= 0 && x < xEnd && y < m_y) {
+                removed += LowerStock(x, y, z);
             }
             cupCirc.Rotate();
         }
     }
+    return removed;
 }
 
-void cStock::ApplyCircularTool(Point3D& p1, Point3D& p2, Point3D& cent, cSimTool& tool, bool isCCW)
+double cStock::ApplyCircularTool(Point3D& p1,
+                                 Point3D& p2,
+                                 Point3D& cent,
+                                 cSimTool& tool,
+                                 bool isCCW,
+                                 int xBegin,
+                                 int xEnd)
 {
+    double removed = 0;
+    xBegin = std::max(xBegin, 0);
+    xEnd = std::min(xEnd, m_x);
     // translate coordinates
     Point3D pi1 = ToInner(p1);
     Point3D pi2 = ToInner(p2);
@@ -610,6 +648,11 @@ void cStock::ApplyCircularTool(Point3D& p1, Point3D& p2, Point3D& cent, cSimTool
     float tstep = (float)SIM_WALK_RES / rad;
     float t = -1;
     for (float r = crad1; r <= crad2; r += (float)SIM_WALK_RES) {
+        if (cpx + r < xBegin - 1 || cpx - r >= xEnd + 1) {
+            // the circle this strand lies on misses the band
+            t += tstep;
+            continue;
+        }
         cupCirc.x = xynorm.x * r;
         cupCirc.y = xynorm.y * r;
         float rotang = (float)SIM_WALK_RES / r;
@@ -623,10 +666,8 @@ void cStock::ApplyCircularTool(Point3D& p1, Point3D& p2, Point3D& cent, cSimTool
         for (int i = 0; i < ndivs; i++) {
             int x = (int)(cpx + cupCirc.x);
             int y = (int)(cpy + cupCirc.y);
-            if (x >= 0 && y >= 0 && x < m_x && y < m_y) {
-                if (m_stock[x][y] > z) {
-                    m_stock[x][y] = z;
-                }
+            if (x >= xBegin && y >= 0 && x < xEnd && y < m_y) {
+                removed += LowerStock(x, y, z);
             }
             z += zstep;
             cupCirc.Rotate();
@@ -638,6 +679,9 @@ void cStock::ApplyCircularTool(Point3D& p1, Point3D& p2, Point3D& cent, cSimTool
     xynorm.SetRotationAngleRad(ang);
     xynorm.Rotate();
     for (float r = 0.5f; r <= rad; r += (float)SIM_WALK_RES) {
+        if (pi2.x + r < xBegin - 1 || pi2.x - r >= xEnd + 1) {
+            continue;
+        }
         Point3D cupCirc(xynorm.x * r, xynorm.y * r, 0);
         float rotang = (float)SIM_WALK_RES / r;
         int ndivs = (int)(pi / rotang) + 1;
@@ -649,16 +693,203 @@ void cStock::ApplyCircularTool(Point3D& p1, Point3D& p2, Point3D& cent, cSimTool
         for (int i = 0; i < ndivs; i++) {
             int x = (int)(pi2.x + cupCirc.x);
             int y = (int)(pi2.y + cupCirc.y);
-            if (x >= 0 && y >= 0 && x < m_x && y < m_y) {
-                if (m_stock[x][y] > z) {
-                    m_stock[x][y] = z;
-                }
+            if (x >= xBegin && y >= 0 && x < xEnd && y < m_y) {
+                removed += LowerStock(x, y, z);
             }
             cupCirc.Rotate();
         }
     }
+    return removed;
 }
 
+// Sweeps the tool along a move that keeps the height z, evaluating the tool profile at the
+// distance of each cell center from the move. The columns of large sweeps over the whole stock
+// are split among threads, as they do not share any cell.
+double cStock::ApplyLevelTool(Point3D& pi1,
+                              Point3D& pi2,
+                              float z,
+                              cSimTool& tool,
+                              int xBegin,
+                              int xEnd)
+{
+    float rad = tool.radius / m_res;
+    int xs = std::max(xBegin, (int)floor(std::min(pi1.x, pi2.x) - rad));
+    int xe = std::min(xEnd - 1, (int)floor(std::max(pi1.x, pi2.x) + rad));
+    int ys = std::max(0, (int)floor(std::min(pi1.y, pi2.y) - rad));
+    int ye = std::min(m_y - 1, (int)floor(std::max(pi1.y, pi2.y) + rad));
+    if (xs > xe || ys > ye || rad <= 0) {
+        return 0;
+    }
+
+    // tool bottom heights sampled along the radius, at a quarter of the stock resolution
+    int samples = (int)(rad * 4) + 1;
+    std::vector<float> profile(samples + 1);
+    for (int i = 0; i <= samples; i++) {
+        profile[i] = z + tool.GetToolProfileAt((float)i / samples);
+    }
+    float sampleScale = samples / rad;
+
+    float dx = pi2.x - pi1.x;
+    float dy = pi2.y - pi1.y;
+    float len2 = dx * dx + dy * dy;
+    float rad2 = rad * rad;
+    auto sweep = [&](int from, int to) {
+        double removed = 0;
+        for (int x = from; x < to; x++) {
+            float cx = x + 0.5f - pi1.x;
+            for (int y = ys; y <= ye; y++) {
+                float cy = y + 0.5f - pi1.y;
+                float t = len2 > SIM_EPSILON ? std::clamp((cx * dx + cy * dy) / len2, 0.0f, 1.0f)
+                                             : 0.0f;
+                float ex = cx - t * dx;
+                float ey = cy - t * dy;
+                float d2 = ex * ex + ey * ey;
+                if (d2 <= rad2) {
+                    removed += LowerStock(x, y, profile[(int)(sqrtf(d2) * sampleScale + 0.5f)]);
+                }
+            }
+        }
+        return removed;
+    };
+
+    int columns = xe - xs + 1;
+    size_t cells = (size_t)columns * (ye - ys + 1);
+    int threadCount = std::min<int>(std::thread::hardware_concurrency(), columns);
+    if (cells < SIM_PARALLEL_CELLS || threadCount < 2 || xBegin > 0 || xEnd < m_x) {
+        return sweep(xs, xe + 1);
+    }
+    std::vector<double> removed(threadCount);
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    int step = (columns + threadCount - 1) / threadCount;
+    for (int i = 0; i < threadCount; i++) {
+        int from = xs + i * step;
+        int to = std::min(xe + 1, from + step);
+        threads.emplace_back([&, i, from, to]() {
+            removed[i] = from < to ? sweep(from, to) : 0;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return std::accumulate(removed.begin(), removed.end(), 0.0);
+}
+
+
+// The stock is split into bands of columns, and each band is machined by its own thread running
+// through all the moves in order. Lowering the stock only ever touches the cells of the band, so
+// the result and the per move volumes are the same as when applying the moves one by one.
+std::vector<double> cStock::ApplyMoves(const std::vector<cStockMove>& moves, cSimTool& tool)
+{
+    int threadCount = std::max(1,
+                               std::min<int>(std::thread::hardware_concurrency(),
+                                             m_x / SIM_MIN_BAND_COLUMNS));
+    int step = (m_x + threadCount - 1) / threadCount;
+    std::vector<std::vector<double>> bandRemoved(threadCount, std::vector<double>(moves.size()));
+    auto machine = [&](int band) {
+        int xBegin = threadCount > 1 ? band * step : 0;
+        int xEnd = threadCount > 1 ? std::min(m_x, xBegin + step) : m_x;
+        for (size_t i = 0; i < moves.size(); i++) {
+            cStockMove move = moves[i];
+            switch (move.type) {
+                case cStockMove::Linear:
+                    bandRemoved[band][i] =
+                        ApplyLinearTool(move.from, move.to, tool, xBegin, xEnd);
+                    break;
+                case cStockMove::Arc:
+                case cStockMove::ArcCCW:
+                    bandRemoved[band][i] = ApplyCircularTool(move.from,
+                                                             move.to,
+                                                             move.center,
+                                                             tool,
+                                                             move.type == cStockMove::ArcCCW,
+                                                             xBegin,
+                                                             xEnd);
+                    break;
+                default:
+                    break;
+            }
+        }
+    };
+
+    if (threadCount < 2) {
+        machine(0);
+    }
+    else {
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount);
+        for (int band = 0; band < threadCount; band++) {
+            threads.emplace_back(machine, band);
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+    }
+
+    std::vector<double> removed(moves.size());
+    for (const auto& band : bandRemoved) {
+        for (size_t i = 0; i < moves.size(); i++) {
+            removed[i] += band[i];
+        }
+    }
+    return removed;
+}
+
+void cStock::GetDeviation(const TopoDS_Shape& target,
+                          std::vector<Base::Vector3d>& points,
+                          std::vector<float>& deviations)
+{
+    points.resize((size_t)m_x * m_y);
+    deviations.resize(points.size());
+    Bnd_Box bounds;
+    BRepBndLib::Add(target, bounds);
+    double top = std::max<double>(m_plane, bounds.IsVoid() ? m_plane : bounds.CornerMax().Z()) + 1;
+
+    // the target top is found by shooting a ray down through each cell center
+    auto measure = [&](int xBegin, int xEnd) {
+        IntCurvesFace_ShapeIntersector intersector;
+        intersector.Load(target, Precision::Confusion());
+        for (int x = xBegin; x < xEnd; x++) {
+            for (int y = 0; y < m_y; y++) {
+                double px = m_px + (x + 0.5) * m_res;
+                double py = m_py + (y + 0.5) * m_res;
+                float height = m_stock[x][y];
+                intersector.Perform(gp_Lin(gp_Pnt(px, py, top), gp_Dir(0, 0, -1)),
+                                    0,
+                                    Precision::Infinite());
+                float deviation;
+                if (intersector.IsDone() && intersector.NbPnt() > 0) {
+                    double hit = Precision::Infinite();
+                    for (int i = 1; i <= intersector.NbPnt(); i++) {
+                        hit = std::min(hit, intersector.WParameter(i));
+                    }
+                    deviation = height - (float)(top - hit);
+                }
+                else {
+                    // no target here, everything above the stock bottom is left over
+                    deviation = std::max(0.0f, height - m_pz);
+                }
+                size_t index = (size_t)x * m_y + y;
+                points[index] = Base::Vector3d(px, py, height);
+                deviations[index] = deviation;
+            }
+        }
+    };
+
+    if (m_x <= 0) {
+        return;
+    }
+    int threadCount = std::max(1, std::min<int>(std::thread::hardware_concurrency(), m_x));
+    int step = (m_x + threadCount - 1) / threadCount;
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (int xBegin = 0; xBegin < m_x; xBegin += step) {
+        threads.emplace_back(measure, xBegin, std::min(m_x, xBegin + step));
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
 
 //************************************************************************************************************
 // Line Segment
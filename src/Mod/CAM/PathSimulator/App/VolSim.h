@@ -25,6 +25,8 @@
 #ifndef PATHSIMULATOR_VolSim_H
 #define PATHSIMULATOR_VolSim_H
 
+#include <algorithm>
+#include <climits>
 #include <vector>
 
 #include <Mod/Mesh/App/Mesh.h>
@@ -36,6 +38,8 @@
 #define SIM_TESSEL_BOT 2
 #define SIM_WALK_RES                                                                               \
     0.6  // step size in pixel units (to make sure all pixels in the path are visited)
+#define SIM_PARALLEL_CELLS 262144  // sweeps over more cells than this are split among threads
+#define SIM_MIN_BAND_COLUMNS 16    // narrowest band of stock columns machined by one thread
 
 struct toolShapePoint
 {
@@ -186,6 +190,22 @@ public:
     float length;
 };
 
+// a tool move resolved from a path command
+struct cStockMove
+{
+    enum Type
+    {
+        None,
+        Linear,
+        Arc,
+        ArcCCW
+    };
+    Type type = None;
+    Point3D from;
+    Point3D to;
+    Point3D center;  // relative to from, for arcs
+};
+
 template<class T>
 class Array2D
 {
@@ -225,14 +245,47 @@ public:
     ~cStock();
     void Tessellate(Mesh::MeshObject& meshOuter, Mesh::MeshObject& meshInner);
     void CreatePocket(float x, float y, float rad, float height);
-    void ApplyLinearTool(Point3D& p1, Point3D& p2, cSimTool& tool);
-    void ApplyCircularTool(Point3D& p1, Point3D& p2, Point3D& cent, cSimTool& tool, bool isCCW);
+    // The apply functions return the volume of stock removed by the move. Only the stock
+    // columns from xBegin up to xEnd are touched, so that disjoint bands of the stock can be
+    // machined concurrently.
+    double ApplyLinearTool(Point3D& p1,
+                           Point3D& p2,
+                           cSimTool& tool,
+                           int xBegin = 0,
+                           int xEnd = INT_MAX);
+    double ApplyCircularTool(Point3D& p1,
+                             Point3D& p2,
+                             Point3D& cent,
+                             cSimTool& tool,
+                             bool isCCW,
+                             int xBegin = 0,
+                             int xEnd = INT_MAX);
+    // applies the moves in order, returns the volume removed by each one
+    std::vector<double> ApplyMoves(const std::vector<cStockMove>& moves, cSimTool& tool);
+    // vertical distance of the stock top above the top of the target shape at each cell center,
+    // negative where the stock was cut below the target
+    void GetDeviation(const TopoDS_Shape& target,
+                      std::vector<Base::Vector3d>& points,
+                      std::vector<float>& deviations);
     inline Point3D ToInner(Point3D& p)
     {
         return Point3D((p.x - m_px) / m_res, (p.y - m_py) / m_res, p.z);
     }
 
 private:
+    double
+    ApplyLevelTool(Point3D& pi1, Point3D& pi2, float z, cSimTool& tool, int xBegin, int xEnd);
+    // lowers the stock at the given cell to z, returns the removed volume
+    inline double LowerStock(int x, int y, float z)
+    {
+        float& height = m_stock[x][y];
+        if (height <= z) {
+            return 0;
+        }
+        double removed = height - std::max(z, m_pz);
+        height = z;
+        return removed > 0 ? removed * m_res * m_res : 0;
+    }
     float FindRectTop(int& xp, int& yp, int& x_size, int& y_size, bool scanHoriz);
     void FindRectBot(int& xp, int& yp, int& x_size, int& y_size, bool scanHoriz);
     void SetFacetPoints(MeshCore::MeshGeomFacet& facet, Point3D& p1, Point3D& p2, Point3D& p3);
@@ -26,7 +26,14 @@
 #include <cstring>
 #include <ctime>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
 #include <numbers>
+#include <random>
+#include <thread>
 
 namespace ClipperLib
 {
@@ -40,6 +47,9 @@ using namespace std;
 #define SAME_POINT_TOL_SQRD_SCALED 4.0
 #define UNUSED(expr) (void)(expr)
 
+// regions may be processed by several threads, this keeps their messages from interleaving
+static std::mutex coutMutex;
+
 //*****************************************
 // Utils - inline
 //*****************************************
@@ -1158,7 +1168,9 @@ public:
 
     double getRandomAngle()
     {
-        return MIN_ANGLE + (MAX_ANGLE - MIN_ANGLE) * double(rand()) / double(RAND_MAX);
+        // own generator, so regions processed in parallel do not share the sequence
+        std::uniform_real_distribution<double> distribution(MIN_ANGLE, MAX_ANGLE);
+        return distribution(randomEngine);
     }
     size_t getPointCount()
     {
@@ -1168,6 +1180,7 @@ public:
 private:
     vector<double> angles;
     vector<double> areas;
+    std::minstd_rand randomEngine;
 };
 
 //***************************************
@@ -1741,7 +1754,7 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths& stockPaths,
     toolRadiusScaled = long(toolDiameter * scaleFactor / 2);
     stepOverScaled = toolRadiusScaled * stepOverFactor;
     progressCallback = &progressCallbackFn;
-    lastProgressTime = clock();
+    lastProgressTime = chrono::steady_clock::now();
     stopProcessing = false;
 
     if (helixRampDiameter < NTOL) {
@@ -1825,6 +1838,8 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths& stockPaths,
     //***************************************
     //	Resolve hierarchy and run processing
     //***************************************
+    // bound paths and tool bound paths of each region
+    std::vector<std::pair<Paths, Paths>> regions;
     double cornerRoundingOffset = 0.15 * toolRadiusScaled / 2;
     if (opType == OperationType::otClearingInside || opType == OperationType::otClearingOutside) {
 
@@ -1877,7 +1892,7 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths& stockPaths,
                 clipof.Clear();
                 clipof.AddPaths(toolBoundPaths, JoinType::jtRound, EndType::etClosedPolygon);
                 clipof.Execute(boundPaths, toolRadiusScaled + finishPassOffsetScaled);
-                ProcessPolyNode(boundPaths, toolBoundPaths);
+                regions.emplace_back(boundPaths, toolBoundPaths);
             }
         }
     }
@@ -1934,14 +1949,121 @@ std::list<AdaptiveOutput> Adaptive2d::Execute(const DPaths& stockPaths,
                     clipof.AddPaths(toolBoundPaths, JoinType::jtRound, EndType::etClosedPolygon);
                     clipof.Execute(boundPaths, toolRadiusScaled + finishPassOffsetScaled);
 
-                    ProcessPolyNode(boundPaths, toolBoundPaths);
+                    regions.emplace_back(boundPaths, toolBoundPaths);
                 }
             }
         }
     }
+    ProcessRegions(regions);
     return results;
 }
 
+void Adaptive2d::ProcessRegions(const std::vector<std::pair<Paths, Paths>>& regions)
+{
+    size_t threadCount = std::min<size_t>(std::thread::hardware_concurrency(), regions.size());
+#ifdef DEV_MODE
+    // perf counters and debug drawing are not thread safe
+    threadCount = 1;
+#endif
+    if (threadCount < 2) {
+        for (const auto& region : regions) {
+            ProcessPolyNode(region.first, region.second);
+        }
+        return;
+    }
+
+    // Regions do not depend on each other, so each worker thread processes them on its own
+    // copy of this object. Progress is collected and reported from the calling thread, as the
+    // callback may call into python.
+    std::mutex mutex;
+    std::condition_variable progressReady;
+    TPaths pendingProgress;
+    size_t runningWorkers = threadCount;
+    std::atomic<bool> stop = stopProcessing;
+    std::function<bool(TPaths)> forwardProgress = [&](TPaths paths) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pendingProgress.insert(pendingProgress.end(), paths.begin(), paths.end());
+        }
+        progressReady.notify_one();
+        return stop.load();
+    };
+
+    std::vector<std::list<AdaptiveOutput>> regionResults(regions.size());
+    std::vector<std::exception_ptr> regionErrors(regions.size());
+    std::atomic<size_t> nextRegion = 0;
+    auto work = [&](Adaptive2d& worker) {
+        for (size_t index = nextRegion++; index < regions.size(); index = nextRegion++) {
+            worker.current_region = current_region + int(index);
+            try {
+                worker.ProcessPolyNode(regions[index].first, regions[index].second);
+            }
+            catch (...) {
+                regionErrors[index] = std::current_exception();
+            }
+            regionResults[index].splice(regionResults[index].end(), worker.results);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            runningWorkers--;
+        }
+        progressReady.notify_one();
+    };
+
+    std::vector<Adaptive2d> workers(threadCount, *this);
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (auto& worker : workers) {
+        worker.results.clear();
+        worker.progressCallback = &forwardProgress;
+        threads.emplace_back(work, std::ref(worker));
+    }
+
+    std::exception_ptr callbackError;
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        progressReady.wait(lock, [&] {
+            return !pendingProgress.empty() || runningWorkers == 0;
+        });
+        if (pendingProgress.empty()) {
+            break;
+        }
+        TPaths progress;
+        progress.swap(pendingProgress);
+        lock.unlock();
+        if (!callbackError && progressCallback && *progressCallback) {
+            try {
+                if ((*progressCallback)(progress)) {
+                    stop = true;
+                }
+            }
+            catch (...) {
+                // stop the workers and rethrow once they are joined
+                callbackError = std::current_exception();
+                stop = true;
+            }
+        }
+        lock.lock();
+    }
+    lock.unlock();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    stopProcessing = stop;
+    current_region += int(regions.size());
+    if (callbackError) {
+        std::rethrow_exception(callbackError);
+    }
+    // keep the output in region order, as if the regions were processed one after the other
+    for (size_t i = 0; i < regions.size(); i++) {
+        if (regionErrors[i]) {
+            std::rethrow_exception(regionErrors[i]);
+        }
+        results.splice(results.end(), regionResults[i]);
+    }
+}
+
 bool Adaptive2d::FindEntryPoint(TPaths& progressPaths,
                                 const Paths& toolBoundPaths,
                                 const Paths& boundPaths,
@@ -2212,21 +2334,24 @@ bool Adaptive2d::ResolveLinkPath(const IntPoint& startPoint,
     double par;
 
     // put a time limit on the resolving the link path
-    clock_t time_limit = (clock_t)(max(keepToolDownDistRatio, 3.0) * CLOCKS_PER_SEC / 6);
+    auto time_limit = chrono::duration_cast<chrono::steady_clock::duration>(
+        chrono::duration<double>(max(keepToolDownDistRatio, 3.0) / 6));
 
-    clock_t time_out = clock() + time_limit;
+    auto time_out = chrono::steady_clock::now() + time_limit;
 
     while (!queue.empty()) {
         if (stopProcessing) {
             return false;
         }
-        if (clock() > time_out) {
+        if (chrono::steady_clock::now() > time_out) {
+            lock_guard<mutex> lock(coutMutex);
             cout << "Unable to resolve tool down linking path (limit reached)." << endl;
             return false;
         }
 
         cnt++;
         if (cnt > limit) {
+            lock_guard<mutex> lock(coutMutex);
             cout << "Unable to resolve tool down linking path @(" << endPoint.X / scaleFactor << ","
                  << endPoint.Y / scaleFactor << ") (" << limit << " points limit reached)." << endl;
             return false;
@@ -2244,6 +2369,7 @@ bool Adaptive2d::ResolveLinkPath(const IntPoint& startPoint,
                                      pointPair.first,
                                      pointPair.second,
                                      clp)) {
+                lock_guard<mutex> lock(coutMutex);
                 cout << "Unable to resolve tool down linking path (self-intersects)." << endl;
                 return false;
             }
@@ -2645,10 +2771,11 @@ void Adaptive2d::AppendToolPath(TPaths& progressPaths,
 
 void Adaptive2d::CheckReportProgress(TPaths& progressPaths, bool force)
 {
-    if (!force && (clock() - lastProgressTime < PROGRESS_TICKS)) {
+    auto now = chrono::steady_clock::now();
+    if (!force && (now - lastProgressTime < PROGRESS_INTERVAL)) {
         return;  // not yet
     }
-    lastProgressTime = clock();
+    lastProgressTime = now;
     if (progressPaths.empty()) {
         return;
     }
@@ -2706,7 +2833,6 @@ void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths)
 {
     Perf_ProcessPolyNode.Start();
     current_region++;
-    cout << "** Processing region: " << current_region << endl;
 
     // node paths are already constrained to tool boundary path for adaptive path before finishing
     // pass
@@ -3137,10 +3263,12 @@ void Adaptive2d::ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths)
                     }
                 };
                 if (remaining.empty()) {
+                    lock_guard<mutex> lock(coutMutex);
                     cout << "All cleared." << endl;
                     break;
                 }
                 else {
+                    lock_guard<mutex> lock(coutMutex);
                     cout << "Clearing " << remaining.size() << " remaining internal path(s)."
                          << endl;
                 }
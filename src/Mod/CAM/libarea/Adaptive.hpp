@@ -23,6 +23,7 @@
 #include "clipper.hpp"
 #include <vector>
 #include <list>
+#include <chrono>
 #include <time.h>
 
 #ifndef ADAPTIVE_HPP
@@ -78,7 +79,7 @@ struct AdaptiveOutput
     int ReturnMotionType;  // MotionType enum, problem with serialization if enum is used
 };
 
-// used to isolate state -> enable potential adding of multi-threaded processing of separate regions
+// used to isolate state -> enables multi-threaded processing of separate regions
 
 class Adaptive2d
 {
@@ -119,11 +120,12 @@ private:
     double optimalCutAreaPD = 0;
     bool stopProcessing = false;
     int current_region = 0;
-    clock_t lastProgressTime = 0;
+    std::chrono::steady_clock::time_point lastProgressTime;
 
     std::function<bool(TPaths)>* progressCallback = NULL;
     Path toolGeometry;  // tool geometry at coord 0,0, should not be modified
 
+    void ProcessRegions(const std::vector<std::pair<Paths, Paths>>& regions);
     void ProcessPolyNode(Paths boundPaths, Paths toolBoundPaths);
     bool FindEntryPoint(TPaths& progressPaths,
                         const Paths& toolBoundPaths,
@@ -199,7 +201,8 @@ private:  // constants for fine tuning
 
     const long PASSES_LIMIT = __LONG_MAX__;              // limit used while debugging
     const long POINTS_PER_PASS_LIMIT = __LONG_MAX__;     // limit used while debugging
-    const clock_t PROGRESS_TICKS = CLOCKS_PER_SEC / 10;  // progress report interval
+    // progress report interval, in wall clock time as clock() runs faster with more threads
+    const std::chrono::steady_clock::duration PROGRESS_INTERVAL = std::chrono::milliseconds(100);
 };
 }  // namespace AdaptivePath
 #endif
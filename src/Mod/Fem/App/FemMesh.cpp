@@ -21,14 +21,26 @@
  ***************************************************************************/
 
 #include <Python.h>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 #include <memory>
+#include <numeric>
+#include <unordered_map>
 
+#include <BRepAdaptor_Curve.hxx>
 #include <BRepBndLib.hxx>
+#include <BRepBuilderAPI_Copy.hxx>
 #include <BRepBuilderAPI_MakeVertex.hxx>
+#include <BRepClass3d_SolidClassifier.hxx>
 #include <BRepExtrema_DistShapeShape.hxx>
+#include <BRepMesh_IncrementalMesh.hxx>
 #include <BRep_Tool.hxx>
 #include <Bnd_Box.hxx>
+#include <GCPnts_QuasiUniformDeflection.hxx>
 #include <SMDS_MeshGroup.hxx>
 #include <SMESHDS_Group.hxx>
 #include <SMESHDS_GroupBase.hxx>
@@ -47,6 +59,8 @@
 #include <StdMeshers_Quadrangle_2D.hxx>
 #include <StdMeshers_Regular_1D.hxx>
 #include <StdMeshers_StartEndLength.hxx>
+#include <TopExp_Explorer.hxx>
+#include <TopoDS.hxx>
 #include <TopoDS_Face.hxx>
 #include <TopoDS_Shape.hxx>
 #include <TopoDS_Solid.hxx>
@@ -65,6 +79,7 @@
 #include <Base/TimeInfo.h>
 #include <Base/Writer.h>
 #include <Mod/Mesh/App/Core/Iterator.h>
+#include <Mod/Part/App/Tools.h>
 
 #include "FemMesh.h"
 #include <FemMeshPy.h>
@@ -557,10 +572,279 @@ std::map<int, int> FemMesh::getccxVolumesByFace(const TopoDS_Face& face) const
     return result;
 }
 
-std::set<int> FemMesh::getNodesBySolid(const TopoDS_Solid& solid) const
+namespace
+{
+
+/*!
+ Rejects points that can not be within the tolerance of a shape, without building a vertex
+ and running BRepExtrema_DistShapeShape for each of them. The faces and edges of the shape are
+ tessellated once and the triangles and segments are put into a sparse uniform grid. A point
+ that is farther from the tessellation than the tessellation error plus the tolerance can not
+ be on the shape. isNear() is const and can be called from several threads.
+ */
+class ShapeNodeLocator
+{
+public:
+    ShapeNodeLocator(const TopoDS_Shape& shape, double tolerance)
+    {
+        Bnd_Box box;
+        BRepBndLib::Add(shape, box);
+        if (box.IsVoid() || box.IsOpen()) {
+            exhaustive = true;
+            return;
+        }
+        double deflection = 0.001 * std::sqrt(box.SquareExtent());
+        // BRepMesh only approximately keeps the deflection, leave some room
+        reach = tolerance + 2.0 * deflection;
+
+        // mesh a copy to leave the triangulation of the caller's shape alone
+        TopoDS_Shape copy = BRepBuilderAPI_Copy(shape, Standard_False).Shape();
+        BRepMesh_IncrementalMesh(copy, deflection, Standard_False, 0.5, Standard_False);
+        for (TopExp_Explorer xp(copy, TopAbs_FACE); xp.More(); xp.Next()) {
+            std::vector<gp_Pnt> points;
+            std::vector<Poly_Triangle> facets;
+            if (!Part::Tools::getTriangulation(TopoDS::Face(xp.Current()), points, facets)) {
+                exhaustive = true;
+                return;
+            }
+            for (const auto& facet : facets) {
+                Standard_Integer n1, n2, n3;
+                facet.Get(n1, n2, n3);
+                prims.push_back({toVector(points[n1]), toVector(points[n2]), toVector(points[n3]), true});
+            }
+        }
+        for (TopExp_Explorer xp(shape, TopAbs_EDGE); xp.More(); xp.Next()) {
+            const TopoDS_Edge& edge = TopoDS::Edge(xp.Current());
+            if (BRep_Tool::Degenerated(edge)) {
+                continue;
+            }
+            BRepAdaptor_Curve curve(edge);
+            GCPnts_QuasiUniformDeflection discretizer(curve, deflection);
+            if (!discretizer.IsDone() || discretizer.NbPoints() < 2) {
+                exhaustive = true;
+                return;
+            }
+            for (int i = 1; i < discretizer.NbPoints(); ++i) {
+                Base::Vector3d p1 = toVector(discretizer.Value(i));
+                Base::Vector3d p2 = toVector(discretizer.Value(i + 1));
+                prims.push_back({p1, p2, p2, false});
+            }
+        }
+        for (TopExp_Explorer xp(shape, TopAbs_VERTEX); xp.More(); xp.Next()) {
+            Base::Vector3d p = toVector(BRep_Tool::Pnt(TopoDS::Vertex(xp.Current())));
+            prims.push_back({p, p, p, false});
+        }
+        if (prims.empty()) {
+            exhaustive = true;
+            return;
+        }
+
+        // the primitives mostly lie on surfaces, so aim for about one per cell on them
+        cellSize = std::max(std::sqrt(box.SquareExtent() / double(prims.size())), 2.0 * reach);
+        for (std::size_t i = 0; i < prims.size(); ++i) {
+            const Prim& prim = prims[i];
+            Base::Vector3d lo(std::min({prim.a.x, prim.b.x, prim.c.x}) - reach,
+                              std::min({prim.a.y, prim.b.y, prim.c.y}) - reach,
+                              std::min({prim.a.z, prim.b.z, prim.c.z}) - reach);
+            Base::Vector3d hi(std::max({prim.a.x, prim.b.x, prim.c.x}) + reach,
+                              std::max({prim.a.y, prim.b.y, prim.c.y}) + reach,
+                              std::max({prim.a.z, prim.b.z, prim.c.z}) + reach);
+            // a large tilted triangle only touches a thin layer of the cells of its box
+            const double touch = cellSize * 0.5 * std::sqrt(3.0) + reach;
+            bool filter = prim.triangle
+                && (cell(hi.x) - cell(lo.x) + 1) * (cell(hi.y) - cell(lo.y) + 1)
+                        * (cell(hi.z) - cell(lo.z) + 1)
+                    > 8;
+            for (long x = cell(lo.x); x <= cell(hi.x); ++x) {
+                for (long y = cell(lo.y); y <= cell(hi.y); ++y) {
+                    for (long z = cell(lo.z); z <= cell(hi.z); ++z) {
+                        Base::Vector3d center((x + 0.5) * cellSize,
+                                              (y + 0.5) * cellSize,
+                                              (z + 0.5) * cellSize);
+                        if (filter
+                            && distanceToTriangle2(center, prim.a, prim.b, prim.c) > touch * touch) {
+                            continue;
+                        }
+                        grid[key(x, y, z)].push_back(i);
+                    }
+                }
+            }
+        }
+    }
+
+    //! false only if the point is certainly farther than the tolerance from the shape
+    bool isNear(const Base::Vector3d& point) const
+    {
+        if (exhaustive) {
+            return true;
+        }
+        auto it = grid.find(key(cell(point.x), cell(point.y), cell(point.z)));
+        if (it == grid.end()) {
+            return false;
+        }
+        const double reach2 = reach * reach;
+        for (std::size_t index : it->second) {
+            const Prim& prim = prims[index];
+            double dist2 = prim.triangle ? distanceToTriangle2(point, prim.a, prim.b, prim.c)
+                                         : distanceToSegment2(point, prim.a, prim.b);
+            if (dist2 <= reach2) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    struct Prim
+    {
+        Base::Vector3d a, b, c;
+        bool triangle;
+    };
+
+    static Base::Vector3d toVector(const gp_Pnt& pnt)
+    {
+        return Base::Vector3d(pnt.X(), pnt.Y(), pnt.Z());
+    }
+
+    long cell(double value) const
+    {
+        return static_cast<long>(std::floor(value / cellSize));
+    }
+
+    static std::uint64_t key(long x, long y, long z)
+    {
+        auto part = [](long v) {
+            return static_cast<std::uint64_t>(v) & 0x1FFFFF;
+        };
+        return (part(x) << 42) | (part(y) << 21) | part(z);
+    }
+
+    static double distanceToSegment2(const Base::Vector3d& p,
+                                     const Base::Vector3d& a,
+                                     const Base::Vector3d& b)
+    {
+        Base::Vector3d ab = b - a;
+        double len2 = ab.Sqr();
+        double t = len2 > 0.0 ? std::clamp((p - a) * ab / len2, 0.0, 1.0) : 0.0;
+        return (a + ab * t - p).Sqr();
+    }
+
+    // closest point on a triangle, see Ericson, Real-Time Collision Detection, 5.1.5
+    static double distanceToTriangle2(const Base::Vector3d& p,
+                                      const Base::Vector3d& a,
+                                      const Base::Vector3d& b,
+                                      const Base::Vector3d& c)
+    {
+        Base::Vector3d ab = b - a;
+        Base::Vector3d ac = c - a;
+        Base::Vector3d ap = p - a;
+        double d1 = ab * ap;
+        double d2 = ac * ap;
+        if (d1 <= 0.0 && d2 <= 0.0) {
+            return ap.Sqr();
+        }
+        Base::Vector3d bp = p - b;
+        double d3 = ab * bp;
+        double d4 = ac * bp;
+        if (d3 >= 0.0 && d4 <= d3) {
+            return bp.Sqr();
+        }
+        double vc = d1 * d4 - d3 * d2;
+        if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0) {
+            return distanceToSegment2(p, a, b);
+        }
+        Base::Vector3d cp = p - c;
+        double d5 = ab * cp;
+        double d6 = ac * cp;
+        if (d6 >= 0.0 && d5 <= d6) {
+            return cp.Sqr();
+        }
+        double vb = d5 * d2 - d1 * d6;
+        if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0) {
+            return distanceToSegment2(p, a, c);
+        }
+        double va = d3 * d6 - d5 * d4;
+        if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0) {
+            return distanceToSegment2(p, b, c);
+        }
+        double denom = va + vb + vc;
+        if (denom <= 0.0) {
+            // degenerated triangle
+            return std::min({distanceToSegment2(p, a, b),
+                             distanceToSegment2(p, a, c),
+                             distanceToSegment2(p, b, c)});
+        }
+        double v = vb / denom;
+        double w = vc / denom;
+        return (a + ab * v + ac * w - p).Sqr();
+    }
+
+    std::vector<Prim> prims;
+    std::unordered_map<std::uint64_t, std::vector<std::size_t>> grid;
+    double cellSize = 1.0;
+    double reach = 0.0;
+    bool exhaustive = false;
+};
+
+/*!
+ Returns the ids of the nodes for which a test returns true. makeTest is called once per
+ thread and returns the test, so a test may keep state that is not thread-safe. The test
+ gets the node position with the mesh transformation applied. Each thread collects into
+ its own buffer, the buffers are merged at the end.
+ */
+template<typename MakeTest>
+std::set<int> findNodes(const SMESHDS_Mesh* meshDS, const Base::Matrix4D& mtrx, const MakeTest& makeTest)
+{
+    std::vector<const SMDS_MeshNode*> nodes;
+    nodes.reserve(meshDS->NbNodes());
+    SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
+    while (aNodeIter->more()) {
+        nodes.push_back(aNodeIter->next());
+    }
+
+    std::vector<int> found;
+#pragma omp parallel
+    {
+        auto test = makeTest();
+        std::vector<int> local;
+#pragma omp for schedule(dynamic, 1024) nowait
+        for (long i = 0; i < static_cast<long>(nodes.size()); ++i) {
+            const SMDS_MeshNode* aNode = nodes[i];
+            double xyz[3];
+            aNode->GetXYZ(xyz);
+            Base::Vector3d vec(xyz[0], xyz[1], xyz[2]);
+            // Apply the matrix to hold the BoundBox in absolute space.
+            vec = mtrx * vec;
+            if (test(vec)) {
+                local.push_back(aNode->GetID());
+            }
+        }
+#pragma omp critical
+        found.insert(found.end(), local.begin(), local.end());
+    }
+
+    return std::set<int>(found.begin(), found.end());
+}
+
+//! exact test if the point is closer than limit to the shape
+bool isWithinDistance(const TopoDS_Shape& shape, const Base::Vector3d& vec, double limit)
 {
-    std::set<int> result;
+    // create a vertex
+    BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x, vec.y, vec.z));
+    TopoDS_Shape s = aBuilder.Vertex();
+    // measure distance
+    BRepExtrema_DistShapeShape measure(shape, s);
+    measure.Perform();
+    if (!measure.IsDone() || measure.NbSolution() < 1) {
+        return false;
+    }
+    return measure.Value() < limit;
+}
+
+}  // namespace
 
+std::set<int> FemMesh::getNodesBySolid(const TopoDS_Solid& solid) const
+{
     Bnd_Box box;
     BRepBndLib::Add(solid, box);
 
@@ -572,50 +856,28 @@ std::set<int> FemMesh::getNodesBySolid(const TopoDS_Solid& solid) const
                         limit,
                         limit);
 
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
+    // only nodes close to the boundary need the distance measurement, for the others it is
+    // enough to know if they are inside
+    ShapeNodeLocator locator(solid, limit);
 
-    std::vector<const SMDS_MeshNode*> nodes;
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        nodes.push_back(aNode);
-    }
-
-#pragma omp parallel for schedule(dynamic)
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        const SMDS_MeshNode* aNode = nodes[i];
-        double xyz[3];
-        aNode->GetXYZ(xyz);
-        Base::Vector3d vec(xyz[0], xyz[1], xyz[2]);
-        // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
-
-        if (!box.IsOut(gp_Pnt(vec.x, vec.y, vec.z))) {
-            // create a vertex
-            BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x, vec.y, vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
-            // measure distance
-            BRepExtrema_DistShapeShape measure(solid, s);
-            measure.Perform();
-            if (!measure.IsDone() || measure.NbSolution() < 1) {
-                continue;
+    return findNodes(myMesh->GetMeshDS(), getTransform(), [&]() {
+        return [&, classifier = std::make_shared<BRepClass3d_SolidClassifier>(solid)](
+                   const Base::Vector3d& vec) {
+            gp_Pnt pnt(vec.x, vec.y, vec.z);
+            if (box.IsOut(pnt)) {
+                return false;
             }
-
-            if (measure.Value() < limit)
-#pragma omp critical
-            {
-                result.insert(aNode->GetID());
+            if (locator.isNear(vec)) {
+                return isWithinDistance(solid, vec, limit);
             }
-        }
-    }
-    return result;
+            classifier->Perform(pnt, limit);
+            return classifier->State() == TopAbs_IN;
+        };
+    });
 }
 
 std::set<int> FemMesh::getNodesByFace(const TopoDS_Face& face) const
 {
-    std::set<int> result;
-
     Bnd_Box box;
     BRepBndLib::Add(
         face,
@@ -625,133 +887,46 @@ std::set<int> FemMesh::getNodesByFace(const TopoDS_Face& face) const
     double limit = BRep_Tool::Tolerance(face);
     box.Enlarge(limit);
 
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
-
-    std::vector<const SMDS_MeshNode*> nodes;
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        nodes.push_back(aNode);
-    }
-
-#pragma omp parallel for schedule(dynamic)
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        const SMDS_MeshNode* aNode = nodes[i];
-        double xyz[3];
-        aNode->GetXYZ(xyz);
-        Base::Vector3d vec(xyz[0], xyz[1], xyz[2]);
-        // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
-
-        if (!box.IsOut(gp_Pnt(vec.x, vec.y, vec.z))) {
-            // create a vertex
-            BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x, vec.y, vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
-            // measure distance
-            BRepExtrema_DistShapeShape measure(face, s);
-            measure.Perform();
-            if (!measure.IsDone() || measure.NbSolution() < 1) {
-                continue;
-            }
+    ShapeNodeLocator locator(face, limit);
 
-            if (measure.Value() < limit)
-#pragma omp critical
-            {
-                result.insert(aNode->GetID());
-            }
-        }
-    }
-
-    return result;
+    return findNodes(myMesh->GetMeshDS(), getTransform(), [&]() {
+        return [&](const Base::Vector3d& vec) {
+            return !box.IsOut(gp_Pnt(vec.x, vec.y, vec.z)) && locator.isNear(vec)
+                && isWithinDistance(face, vec, limit);
+        };
+    });
 }
 
 std::set<int> FemMesh::getNodesByEdge(const TopoDS_Edge& edge) const
 {
-    std::set<int> result;
-
     Bnd_Box box;
     BRepBndLib::Add(edge, box);
     // limit where the mesh node belongs to the edge:
     double limit = BRep_Tool::Tolerance(edge);
     box.Enlarge(limit);
 
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
-
-    std::vector<const SMDS_MeshNode*> nodes;
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        nodes.push_back(aNode);
-    }
-
-#pragma omp parallel for schedule(dynamic)
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        const SMDS_MeshNode* aNode = nodes[i];
-        double xyz[3];
-        aNode->GetXYZ(xyz);
-        Base::Vector3d vec(xyz[0], xyz[1], xyz[2]);
-        // Apply the matrix to hold the BoundBox in absolute space.
-        vec = Mtrx * vec;
-
-        if (!box.IsOut(gp_Pnt(vec.x, vec.y, vec.z))) {
-            // create a vertex
-            BRepBuilderAPI_MakeVertex aBuilder(gp_Pnt(vec.x, vec.y, vec.z));
-            TopoDS_Shape s = aBuilder.Vertex();
-            // measure distance
-            BRepExtrema_DistShapeShape measure(edge, s);
-            measure.Perform();
-            if (!measure.IsDone() || measure.NbSolution() < 1) {
-                continue;
-            }
+    ShapeNodeLocator locator(edge, limit);
 
-            if (measure.Value() < limit)
-#pragma omp critical
-            {
-                result.insert(aNode->GetID());
-            }
-        }
-    }
-
-    return result;
+    return findNodes(myMesh->GetMeshDS(), getTransform(), [&]() {
+        return [&](const Base::Vector3d& vec) {
+            return !box.IsOut(gp_Pnt(vec.x, vec.y, vec.z)) && locator.isNear(vec)
+                && isWithinDistance(edge, vec, limit);
+        };
+    });
 }
 
 std::set<int> FemMesh::getNodesByVertex(const TopoDS_Vertex& vertex) const
 {
-    std::set<int> result;
-
     double limit = BRep_Tool::Tolerance(vertex);
     limit *= limit;  // use square to improve speed
     gp_Pnt pnt = BRep_Tool::Pnt(vertex);
     Base::Vector3d node(pnt.X(), pnt.Y(), pnt.Z());
 
-    // get the current transform of the FemMesh
-    const Base::Matrix4D Mtrx(getTransform());
-
-    std::vector<const SMDS_MeshNode*> nodes;
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        nodes.push_back(aNode);
-    }
-
-#pragma omp parallel for schedule(dynamic)
-    for (size_t i = 0; i < nodes.size(); ++i) {
-        const SMDS_MeshNode* aNode = nodes[i];
-        double xyz[3];
-        aNode->GetXYZ(xyz);
-        Base::Vector3d vec(xyz[0], xyz[1], xyz[2]);
-        vec = Mtrx * vec;
-
-        if (Base::DistanceP2(node, vec) <= limit)
-#pragma omp critical
-        {
-            result.insert(aNode->GetID());
-        }
-    }
-
-    return result;
+    return findNodes(myMesh->GetMeshDS(), getTransform(), [&]() {
+        return [&](const Base::Vector3d& vec) {
+            return Base::DistanceP2(node, vec) <= limit;
+        };
+    });
 }
 
 std::list<int> FemMesh::getElementNodes(int id) const
@@ -1656,6 +1831,118 @@ void FemMesh::writeVTK(const std::string& fileName, bool highest) const
 #endif
 }
 
+namespace
+{
+
+// elements of one element type, the node ids are stored in the written node order
+struct ElementBlock
+{
+    std::vector<int> ids;
+    std::vector<int> nodes;
+};
+
+void addElement(ElementBlock& block, const SMDS_MeshElement* elem, const std::vector<int>& order)
+{
+    block.ids.push_back(elem->GetID());
+    for (int jt : order) {
+        block.nodes.push_back(elem->GetNode(jt)->GetID());
+    }
+}
+
+// sort the elements by their ID to get sorted output
+void sortElements(ElementBlock& block)
+{
+    if (block.ids.empty() || std::ranges::is_sorted(block.ids)) {
+        return;
+    }
+
+    const size_t numNodes = block.nodes.size() / block.ids.size();
+    std::vector<size_t> perm(block.ids.size());
+    std::iota(perm.begin(), perm.end(), 0);
+    std::ranges::sort(perm, [&block](size_t lhs, size_t rhs) {
+        return block.ids[lhs] < block.ids[rhs];
+    });
+
+    ElementBlock sorted;
+    sorted.ids.reserve(block.ids.size());
+    sorted.nodes.reserve(block.nodes.size());
+    for (size_t i : perm) {
+        sorted.ids.push_back(block.ids[i]);
+        auto first = block.nodes.begin() + i * numNodes;
+        sorted.nodes.insert(sorted.nodes.end(), first, first + numNodes);
+    }
+    block = std::move(sorted);
+}
+
+void appendInt(std::string& line, long value)
+{
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    line.append(buffer, result.ptr);
+}
+
+// same output as a stream with precision 13, see
+// https://forum.freecad.org/viewtopic.php?f=18&t=22759#p176669
+// std::to_chars is not used for double values because it is not available on older macOS
+void appendDouble(std::string& line, double value)
+{
+    char buffer[32];
+    int len = std::snprintf(buffer, sizeof(buffer), "%.13g", value);
+    line.append(buffer, len);
+}
+
+/*!
+ Writes count lines that are created by format(line, index). The lines are formatted in
+ parallel into buffers that are written in order. This is done in batches to only hold a
+ part of the file in memory.
+ */
+template<typename Format>
+void writeLines(std::ostream& out, long count, const Format& format)
+{
+    constexpr long linesPerBuffer = 4096;
+    constexpr long numBuffers = 256;
+    std::vector<std::string> buffers(numBuffers);
+    for (long batch = 0; batch < count; batch += linesPerBuffer * numBuffers) {
+        const long batchEnd = std::min(count, batch + linesPerBuffer * numBuffers);
+        const long usedBuffers = (batchEnd - batch + linesPerBuffer - 1) / linesPerBuffer;
+#pragma omp parallel for schedule(dynamic, 1)
+        for (long b = 0; b < usedBuffers; ++b) {
+            std::string& buffer = buffers[b];
+            buffer.clear();
+            const long first = batch + b * linesPerBuffer;
+            const long last = std::min(batchEnd, first + linesPerBuffer);
+            for (long i = first; i < last; ++i) {
+                format(buffer, i);
+            }
+        }
+        for (long b = 0; b < usedBuffers; ++b) {
+            out.write(buffers[b].data(), static_cast<std::streamsize>(buffers[b].size()));
+        }
+    }
+}
+
+void writeElements(std::ostream& out, const ElementBlock& block)
+{
+    const long numElems = static_cast<long>(block.ids.size());
+    if (numElems == 0) {
+        return;
+    }
+
+    const size_t numNodes = block.nodes.size() / block.ids.size();
+    writeLines(out, numElems, [&block, numNodes](std::string& line, long i) {
+        appendInt(line, block.ids[i]);
+        const int* nodes = block.nodes.data() + i * numNodes;
+        for (size_t ct = 0; ct < numNodes; ++ct) {
+            // Calculix allows max 16 entries in one line, a hexa20 has more !
+            line += (ct == 15) ? ",\n" : ", ";
+            appendInt(line, nodes[ct]);
+        }
+        line += '\n';
+    });
+}
+
+}  // namespace
+
 void FemMesh::writeABAQUS(const std::string& Filename,
                           int elemParam,
                           bool groupParam,
@@ -1887,36 +2174,35 @@ void FemMesh::writeABAQUS(const std::string& Filename,
 
 
     // get all data --> Extract Nodes and Elements of the current SMESH datastructure
-    using VertexMap = std::map<int, Base::Vector3d>;
-    using NodesMap = std::map<int, std::vector<int>>;
-    using ElementsMap = std::map<std::string, NodesMap>;
+    // The element nodes are read sequentially, SMESH reads them through its own vtk grid which
+    // is not safe to do from several threads. The output is then formatted in parallel.
+    using ElementsMap = std::map<std::string, ElementBlock>;
+    const SMESHDS_Mesh* meshDS = myMesh->GetMeshDS();
 
     // get nodes
-    VertexMap vertexMap;  // empty nodes map
-    SMDS_NodeIteratorPtr aNodeIter = myMesh->GetMeshDS()->nodesIterator();
-    Base::Vector3d current_node;
+    std::vector<const SMDS_MeshNode*> nodes;
+    nodes.reserve(meshDS->NbNodes());
+    SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
     while (aNodeIter->more()) {
-        const SMDS_MeshNode* aNode = aNodeIter->next();
-        current_node.Set(aNode->X(), aNode->Y(), aNode->Z());
-        current_node = _Mtrx * current_node;
-        vertexMap[aNode->GetID()] = current_node;
+        nodes.push_back(aNodeIter->next());
+    }
+    // This way we get sorted output.
+    // See https://forum.freecad.org/viewtopic.php?f=18&t=12646&start=40#p103004
+    auto byId = [](const SMDS_MeshNode* lhs, const SMDS_MeshNode* rhs) {
+        return lhs->GetID() < rhs->GetID();
+    };
+    if (!std::ranges::is_sorted(nodes, byId)) {
+        std::ranges::sort(nodes, byId);
     }
 
     // get volumes
     ElementsMap elementsMapVol;  // empty volumes map
-    SMDS_VolumeIteratorPtr aVolIter = myMesh->GetMeshDS()->volumesIterator();
+    SMDS_VolumeIteratorPtr aVolIter = meshDS->volumesIterator();
     while (aVolIter->more()) {
         const SMDS_MeshVolume* aVol = aVolIter->next();
-        std::pair<int, std::vector<int>> apair;
-        apair.first = aVol->GetID();
-        int numNodes = aVol->NbNodes();
-        std::map<int, std::string>::iterator it = volTypeMap.find(numNodes);
+        std::map<int, std::string>::iterator it = volTypeMap.find(aVol->NbNodes());
         if (it != volTypeMap.end()) {
-            const std::vector<int>& order = elemOrderMap[it->second];
-            for (int jt : order) {
-                apair.second.push_back(aVol->GetNode(jt)->GetID());
-            }
-            elementsMapVol[it->second].insert(apair);
+            addElement(elementsMapVol[it->second], aVol, elemOrderMap[it->second]);
         }
     }
 
@@ -1926,19 +2212,12 @@ void FemMesh::writeABAQUS(const std::string& Filename,
     if ((elemParam == 0) || (elemParam == 1 && elementsMapVol.empty())) {
         // for elemParam = 1 we only fill the elementsMapFac if the elmentsMapVol is empty
         // we're going to fill the elementsMapFac with all faces
-        SMDS_FaceIteratorPtr aFaceIter = myMesh->GetMeshDS()->facesIterator();
+        SMDS_FaceIteratorPtr aFaceIter = meshDS->facesIterator();
         while (aFaceIter->more()) {
             const SMDS_MeshFace* aFace = aFaceIter->next();
-            std::pair<int, std::vector<int>> apair;
-            apair.first = aFace->GetID();
-            int numNodes = aFace->NbNodes();
-            std::map<int, std::string>::iterator it = faceTypeMap.find(numNodes);
+            std::map<int, std::string>::iterator it = faceTypeMap.find(aFace->NbNodes());
             if (it != faceTypeMap.end()) {
-                const std::vector<int>& order = elemOrderMap[it->second];
-                for (int jt : order) {
-                    apair.second.push_back(aFace->GetNode(jt)->GetID());
-                }
-                elementsMapFac[it->second].insert(apair);
+                addElement(elementsMapFac[it->second], aFace, elemOrderMap[it->second]);
             }
         }
     }
@@ -1946,17 +2225,10 @@ void FemMesh::writeABAQUS(const std::string& Filename,
         // we're going to fill the elementsMapFac with the facesOnly
         std::set<int> facesOnly = getFacesOnly();
         for (int itfa : facesOnly) {
-            std::pair<int, std::vector<int>> apair;
-            apair.first = itfa;
-            const SMDS_MeshElement* aFace = myMesh->GetMeshDS()->FindElement(itfa);
-            int numNodes = aFace->NbNodes();
-            std::map<int, std::string>::iterator it = faceTypeMap.find(numNodes);
+            const SMDS_MeshElement* aFace = meshDS->FindElement(itfa);
+            std::map<int, std::string>::iterator it = faceTypeMap.find(aFace->NbNodes());
             if (it != faceTypeMap.end()) {
-                const std::vector<int>& order = elemOrderMap[it->second];
-                for (int jt : order) {
-                    apair.second.push_back(aFace->GetNode(jt)->GetID());
-                }
-                elementsMapFac[it->second].insert(apair);
+                addElement(elementsMapFac[it->second], aFace, elemOrderMap[it->second]);
             }
         }
     }
@@ -1967,19 +2239,12 @@ void FemMesh::writeABAQUS(const std::string& Filename,
     if ((elemParam == 0) || (elemParam == 1 && elementsMapVol.empty() && elementsMapFac.empty())) {
         // for elemParam = 1 we only fill the elementsMapEdg if the elmentsMapVol
         // and elmentsMapFac are empty we're going to fill the elementsMapEdg with all edges
-        SMDS_EdgeIteratorPtr aEdgeIter = myMesh->GetMeshDS()->edgesIterator();
+        SMDS_EdgeIteratorPtr aEdgeIter = meshDS->edgesIterator();
         while (aEdgeIter->more()) {
             const SMDS_MeshEdge* aEdge = aEdgeIter->next();
-            std::pair<int, std::vector<int>> apair;
-            apair.first = aEdge->GetID();
-            int numNodes = aEdge->NbNodes();
-            std::map<int, std::string>::iterator it = edgeTypeMap.find(numNodes);
+            std::map<int, std::string>::iterator it = edgeTypeMap.find(aEdge->NbNodes());
             if (it != edgeTypeMap.end()) {
-                const std::vector<int>& order = elemOrderMap[it->second];
-                for (int jt : order) {
-                    apair.second.push_back(aEdge->GetNode(jt)->GetID());
-                }
-                elementsMapEdg[it->second].insert(apair);
+                addElement(elementsMapEdg[it->second], aEdge, elemOrderMap[it->second]);
             }
         }
     }
@@ -1987,28 +2252,25 @@ void FemMesh::writeABAQUS(const std::string& Filename,
         // we're going to fill the elementsMapEdg with the edgesOnly
         std::set<int> edgesOnly = getEdgesOnly();
         for (int ited : edgesOnly) {
-            std::pair<int, std::vector<int>> apair;
-            apair.first = ited;
-            const SMDS_MeshElement* aEdge = myMesh->GetMeshDS()->FindElement(ited);
-            int numNodes = aEdge->NbNodes();
-            std::map<int, std::string>::iterator it = edgeTypeMap.find(numNodes);
+            const SMDS_MeshElement* aEdge = meshDS->FindElement(ited);
+            std::map<int, std::string>::iterator it = edgeTypeMap.find(aEdge->NbNodes());
             if (it != edgeTypeMap.end()) {
-                const std::vector<int>& order = elemOrderMap[it->second];
-                for (int jt : order) {
-                    apair.second.push_back(aEdge->GetNode(jt)->GetID());
-                }
-                elementsMapEdg[it->second].insert(apair);
+                addElement(elementsMapEdg[it->second], aEdge, elemOrderMap[it->second]);
             }
         }
     }
 
+    for (ElementsMap* elementsMap : {&elementsMapVol, &elementsMapFac, &elementsMapEdg}) {
+        for (auto& it : *elementsMap) {
+            sortElements(it.second);
+        }
+    }
+
     // write all data to file
     // take also care of special characters in path
     // https://forum.freecad.org/viewtopic.php?f=10&t=37436
     Base::FileInfo fi(Filename);
     Base::ofstream anABAQUS_Output(fi);
-    // https://forum.freecad.org/viewtopic.php?f=18&t=22759#p176669
-    anABAQUS_Output.precision(13);
 
     // add some text and make sure one of the known elemParam values is used
     anABAQUS_Output << "** written by FreeCAD inp file writer for CalculiX,Abaqus meshes"
@@ -2039,6 +2301,7 @@ void FemMesh::writeABAQUS(const std::string& Filename,
 
     // Axisymmetric, plane strain and plane stress elements expect nodes in the plane z=0.
     // Set the z coordinate to 0 to avoid possible rounding errors.
+    std::vector<char> inPlane;
     switch (faceVariant) {
         case ABAQUS_FaceVariant::Stress:
         case ABAQUS_FaceVariant::Stress_Reduced:
@@ -2046,13 +2309,10 @@ void FemMesh::writeABAQUS(const std::string& Filename,
         case ABAQUS_FaceVariant::Strain_Reduced:
         case ABAQUS_FaceVariant::Axisymmetric:
         case ABAQUS_FaceVariant::Axisymmetric_Reduced:
+            inPlane.assign(nodes.empty() ? 0 : nodes.back()->GetID() + 1, 0);
             for (const auto& elMap : elementsMapFac) {
-                const NodesMap& nodeMap = elMap.second;
-                for (const auto& nodes : nodeMap) {
-                    for (int n : nodes.second) {
-                        Base::Vector3d& vertex = vertexMap[n];
-                        vertex.z = 0.0;
-                    }
+                for (int n : elMap.second.nodes) {
+                    inPlane[n] = 1;
                 }
             }
             break;
@@ -2060,14 +2320,26 @@ void FemMesh::writeABAQUS(const std::string& Filename,
             break;
     }
 
-    // This way we get sorted output.
-    // See https://forum.freecad.org/viewtopic.php?f=18&t=12646&start=40#p103004
-    for (const auto& it : vertexMap) {
-        anABAQUS_Output << it.first << ", " << it.second.x << ", " << it.second.y << ", "
-                        << it.second.z << std::endl;
-    }
+    writeLines(anABAQUS_Output,
+               static_cast<long>(nodes.size()),
+               [this, &nodes, &inPlane](std::string& line, long i) {
+                   const SMDS_MeshNode* aNode = nodes[i];
+                   double xyz[3];
+                   aNode->GetXYZ(xyz);
+                   Base::Vector3d vertex = _Mtrx * Base::Vector3d(xyz[0], xyz[1], xyz[2]);
+                   if (!inPlane.empty() && inPlane[aNode->GetID()]) {
+                       vertex.z = 0.0;
+                   }
+                   appendInt(line, aNode->GetID());
+                   line += ", ";
+                   appendDouble(line, vertex.x);
+                   line += ", ";
+                   appendDouble(line, vertex.y);
+                   line += ", ";
+                   appendDouble(line, vertex.z);
+                   line += '\n';
+               });
     anABAQUS_Output << std::endl << std::endl;
-    ;
 
 
     // write volumes to file
@@ -2076,27 +2348,7 @@ void FemMesh::writeABAQUS(const std::string& Filename,
         for (const auto& it : elementsMapVol) {
             anABAQUS_Output << "** Volume elements" << std::endl;
             anABAQUS_Output << "*Element, TYPE=" << it.first << ", ELSET=Evolumes" << std::endl;
-            for (const auto& jt : it.second) {
-                anABAQUS_Output << jt.first;
-                // Calculix allows max 16 entries in one line, a hexa20 has more !
-                int ct = 0;  // counter
-                bool first_line = true;
-                for (auto kt = jt.second.begin(); kt != jt.second.end(); ++kt, ++ct) {
-                    if (ct < 15) {
-                        anABAQUS_Output << ", " << *kt;
-                    }
-                    else {
-                        if (first_line) {
-                            anABAQUS_Output << "," << std::endl << *kt;
-                            first_line = false;
-                        }
-                        else {
-                            anABAQUS_Output << ", " << *kt;
-                        }
-                    }
-                }
-                anABAQUS_Output << std::endl;
-            }
+            writeElements(anABAQUS_Output, it.second);
         }
         elsetname += "Evolumes";
         anABAQUS_Output << std::endl;
@@ -2107,13 +2359,7 @@ void FemMesh::writeABAQUS(const std::string& Filename,
         for (const auto& it : elementsMapFac) {
             anABAQUS_Output << "** Face elements" << std::endl;
             anABAQUS_Output << "*Element, TYPE=" << it.first << ", ELSET=Efaces" << std::endl;
-            for (const auto& jt : it.second) {
-                anABAQUS_Output << jt.first;
-                for (int kt : jt.second) {
-                    anABAQUS_Output << ", " << kt;
-                }
-                anABAQUS_Output << std::endl;
-            }
+            writeElements(anABAQUS_Output, it.second);
         }
         if (elsetname.empty()) {
             elsetname += "Efaces";
@@ -2129,13 +2375,7 @@ void FemMesh::writeABAQUS(const std::string& Filename,
         for (const auto& it : elementsMapEdg) {
             anABAQUS_Output << "** Edge elements" << std::endl;
             anABAQUS_Output << "*Element, TYPE=" << it.first << ", ELSET=Eedges" << std::endl;
-            for (const auto& jt : it.second) {
-                anABAQUS_Output << jt.first;
-                for (int kt : jt.second) {
-                    anABAQUS_Output << ", " << kt;
-                }
-                anABAQUS_Output << std::endl;
-            }
+            writeElements(anABAQUS_Output, it.second);
         }
         if (elsetname.empty()) {
             elsetname += "Eedges";
@@ -2205,15 +2445,20 @@ void FemMesh::writeABAQUS(const std::string& Filename,
             }
 
             // get and write group elements
-            std::set<int> ids;
+            std::vector<int> ids;
             SMDS_ElemIteratorPtr aElemIter = myMesh->GetGroup(it)->GetGroupDS()->GetElements();
             while (aElemIter->more()) {
                 const SMDS_MeshElement* aElement = aElemIter->next();
-                ids.insert(aElement->GetID());
-            }
-            for (int it : ids) {
-                anABAQUS_Output << it << std::endl;
+                ids.push_back(aElement->GetID());
             }
+            std::ranges::sort(ids);
+            ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+            writeLines(anABAQUS_Output,
+                       static_cast<long>(ids.size()),
+                       [&ids](std::string& line, long i) {
+                           appendInt(line, ids[i]);
+                           line += '\n';
+                       });
 
             // write newline after each group
             anABAQUS_Output << std::endl;
@@ -21,13 +21,17 @@
  ***************************************************************************/
 
 #include <Python.h>
+#include <algorithm>
+#include <list>
 #include <vtkDoubleArray.h>
 #include <vtkPointData.h>
 #include <vtkAlgorithm.h>
 #include <vtkAlgorithmOutput.h>
 #include <vtkUnstructuredGrid.h>
 #include <vtkInformation.h>
+#include <vtkStreamingDemandDrivenPipeline.h>
 
+#include <App/Application.h>
 #include <App/FeaturePythonPyImp.h>
 #include <App/Document.h>
 #include <Base/Console.h>
@@ -42,6 +46,100 @@
 using namespace Fem;
 using namespace App;
 
+namespace
+{
+
+// latest modification of the algorithm or any algorithm upstream of it
+vtkMTimeType getPipelineMTime(vtkAlgorithm* algo)
+{
+    vtkMTimeType time = algo->GetMTime();
+    for (int port = 0; port < algo->GetNumberOfInputPorts(); ++port) {
+        for (int i = 0; i < algo->GetNumberOfInputConnections(port); ++i) {
+            vtkAlgorithmOutput* input = algo->GetInputConnection(port, i);
+            if (input && input->GetProducer()) {
+                time = std::max(time, getPipelineMTime(input->GetProducer()));
+            }
+        }
+    }
+    return time;
+}
+
+//! outputs of computed frames of all filters, most recently used first. The memory budget
+//! is shared by all filters, so it also holds for many filters and open documents.
+class FrameCache
+{
+public:
+    static FrameCache& instance()
+    {
+        static FrameCache cache;
+        return cache;
+    }
+
+    vtkDataObject* find(const FemPostFilter* owner, double frame)
+    {
+        auto it = std::ranges::find_if(entries, [owner, frame](const Entry& entry) {
+            return entry.owner == owner && entry.frame == frame;
+        });
+        if (it == entries.end()) {
+            return nullptr;
+        }
+
+        entries.splice(entries.begin(), entries, it);
+        return entries.front().data;
+    }
+
+    void add(const FemPostFilter* owner, double frame, vtkDataObject* data)
+    {
+        ParameterGrp::handle hGrp = App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Mod/Fem/General");
+        unsigned long budget = hGrp->GetUnsigned("PostFrameCacheSize", 512) * 1024;
+
+        unsigned long size = data->GetActualMemorySize();
+        if (size > budget) {
+            return;
+        }
+
+        // the algorithm reuses its output object for the next frame, so keep a copy
+        auto copy = vtkSmartPointer<vtkDataObject>::Take(data->NewInstance());
+        copy->DeepCopy(data);
+        entries.push_front({owner, frame, copy, size});
+        totalSize += size;
+
+        // drop the least recently used frames of any filter
+        while (totalSize > budget) {
+            totalSize -= entries.back().size;
+            entries.pop_back();
+        }
+    }
+
+    void remove(const FemPostFilter* owner)
+    {
+        for (auto it = entries.begin(); it != entries.end();) {
+            if (it->owner == owner) {
+                totalSize -= it->size;
+                it = entries.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+    }
+
+private:
+    struct Entry
+    {
+        const FemPostFilter* owner;
+        double frame;
+        vtkSmartPointer<vtkDataObject> data;
+        unsigned long size;  // in KiB
+    };
+
+    std::list<Entry> entries;
+    unsigned long totalSize = 0;  // in KiB
+};
+
+}  // namespace
+
 PROPERTY_SOURCE(Fem::FemPostFilter, Fem::FemPostObject)
 
 
@@ -65,7 +163,10 @@ FemPostFilter::FemPostFilter()
     addFilterPipeline(pipeline, "__passthrough__");
 }
 
-FemPostFilter::~FemPostFilter() = default;
+FemPostFilter::~FemPostFilter()
+{
+    FrameCache::instance().remove(this);
+}
 
 
 void FemPostFilter::addFilterPipeline(const FemPostFilter::FilterPipeline& p, std::string name)
@@ -203,6 +304,13 @@ DocumentObjectExecReturn* FemPostFilter::execute()
             return StdReturn;
         }
 
+        // a frame computed before with an unchanged pipeline is not computed again
+        vtkMTimeType time = getPipelineMTime(output);
+        if (vtkDataObject* cached = findCachedFrame(Frame.getValue(), time)) {
+            Data.setValue(cached);
+            return StdReturn;
+        }
+
         if (Frame.getValue() > 0) {
             output->UpdateTimeStep(Frame.getValue());
         }
@@ -211,10 +319,36 @@ DocumentObjectExecReturn* FemPostFilter::execute()
         }
 
         Data.setValue(output->GetOutputDataObject(0));
+
+        // only worth it if the user can switch between frames
+        vtkInformation* info = output->GetOutputInformation(0);
+        if (info->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS()) > 1) {
+            cacheFrame(Frame.getValue(), time, output->GetOutputDataObject(0));
+        }
     }
     return StdReturn;
 }
 
+vtkDataObject* FemPostFilter::findCachedFrame(double frame, vtkMTimeType time)
+{
+    if (time != m_frame_cache_time) {
+        FrameCache::instance().remove(this);
+        m_frame_cache_time = time;
+        return nullptr;
+    }
+
+    return FrameCache::instance().find(this, frame);
+}
+
+void FemPostFilter::cacheFrame(double frame, vtkMTimeType time, vtkDataObject* data)
+{
+    if (!m_frame_caching || !data || time != m_frame_cache_time) {
+        return;
+    }
+
+    FrameCache::instance().add(this, frame, data);
+}
+
 bool FemPostFilter::dataIsAvailable()
 {
     auto algo = getFilterOutput();
@@ -302,6 +436,14 @@ void FemPostFilter::setTransformLocation(TransformLocation loc)
     m_transform_location = loc;
 }
 
+void FemPostFilter::setFrameCaching(bool on)
+{
+    m_frame_caching = on;
+    if (!on) {
+        FrameCache::instance().remove(this);
+    }
+}
+
 PyObject* FemPostFilter::getPyObject()
 {
     if (PythonObject.is(Py::_None())) {
@@ -418,6 +560,9 @@ FemPostDataAlongLineFilter::FemPostDataAlongLineFilter()
 
     addFilterPipeline(clip, "DataAlongLine");
     setActiveFilterPipeline("DataAlongLine");
+
+    // the plot data is taken from the probe filter output
+    setFrameCaching(false);
 }
 
 FemPostDataAlongLineFilter::~FemPostDataAlongLineFilter() = default;
@@ -586,6 +731,9 @@ FemPostDataAtPointFilter::FemPostDataAtPointFilter()
 
     addFilterPipeline(clip, "DataAtPoint");
     setActiveFilterPipeline("DataAtPoint");
+
+    // the plot data is taken from the probe filter output
+    setFrameCaching(false);
 }
 
 FemPostDataAtPointFilter::~FemPostDataAtPointFilter() = default;
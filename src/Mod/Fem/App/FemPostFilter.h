@@ -82,6 +82,10 @@ protected:
     // Transformation handling
     void setTransformLocation(TransformLocation loc);
 
+    // Caching of the outputs of already computed frames. Filters that read the vtk output of
+    // their algorithms directly need to disable it.
+    void setFrameCaching(bool on);
+
     friend class FemPostFilterPy;
 
 public:
@@ -107,6 +111,14 @@ private:
     bool m_running_setup = false;
     TransformLocation m_transform_location = TransformLocation::output;
 
+    // the cached outputs of computed frames are valid as long as the modification time of
+    // the upstream vtk pipeline does not change
+    vtkMTimeType m_frame_cache_time = 0;
+    bool m_frame_caching = true;
+
+    vtkDataObject* findCachedFrame(double frame, vtkMTimeType time);
+    void cacheFrame(double frame, vtkMTimeType time, vtkDataObject* data);
+
     void pipelineChanged();  // inform parents that the pipeline changed
 };
 
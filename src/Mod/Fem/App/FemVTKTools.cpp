@@ -23,11 +23,26 @@
 
 
 #include <Python.h>
+#include <algorithm>
 #include <charconv>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
+#include <iterator>
 #include <map>
 #include <memory>
+#include <string_view>
+
+#include <FCConfig.h>
+
+#if defined(FC_OS_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include <SMESHDS_Mesh.hxx>
 #include <SMESH_Mesh.hxx>
@@ -40,9 +55,12 @@
 #include <vtkFloatArray.h>
 #include <vtkHexahedron.h>
 #include <vtkIdList.h>
+#include <vtkIdTypeArray.h>
 #include <vtkLine.h>
 #include <vtkMultiBlockDataSet.h>
+#include <vtkNew.h>
 #include <vtkPointData.h>
+#include <vtkPoints.h>
 #include <vtkPyramid.h>
 #include <vtkQuad.h>
 #include <vtkQuadraticEdge.h>
@@ -57,6 +75,7 @@
 #include <vtkTriangle.h>
 #include <vtkUnsignedCharArray.h>
 #include <vtkUnstructuredGrid.h>
+#include <vtkVersion.h>
 #include <vtkWedge.h>
 #include <vtkXMLMultiBlockDataWriter.h>
 #include <vtkXMLPUnstructuredGridReader.h>
@@ -68,6 +87,7 @@
 #include <App/DocumentObject.h>
 #include <Base/Console.h>
 #include <Base/FileInfo.h>
+#include <Base/Stream.h>
 #include <Base/TimeInfo.h>
 #include <Base/Type.h>
 
@@ -104,34 +124,69 @@ void writeVTKFile(const char* filename, vtkSmartPointer<vtkUnstructuredGrid> dat
 namespace
 {
 
-// Helper function to fill vtkCellArray from SMDS_Mesh using vtk cell order
-template<typename T, typename E>
-void fillVtkArray(vtkSmartPointer<vtkCellArray>& elemArray, std::vector<int>& types, const E* elem)
+// Helper function to build the vtkCellArray of all elements at once, using vtk cell order.
+// The arrays are sized up front from the node counts and written directly, instead of
+// creating a vtkCell per element and appending it.
+void setGridCells(vtkUnstructuredGrid* grid, const std::vector<const SMDS_MeshElement*>& elems)
 {
-    vtkSmartPointer<T> cell = vtkSmartPointer<T>::New();
-    const std::vector<int>& order = SMDS_MeshCell::toVtkOrder(elem->GetEntityType());
-    if (!order.empty()) {
-        for (int i = 0; i < elem->NbNodes(); ++i) {
-            cell->GetPointIds()->SetId(i, elem->GetNode(order[i])->GetID() - 1);
+    const vtkIdType nCells = static_cast<vtkIdType>(elems.size());
+    std::vector<int> types(elems.size());
+    vtkSmartPointer<vtkIdTypeArray> offsets = vtkSmartPointer<vtkIdTypeArray>::New();
+    offsets->SetNumberOfValues(nCells + 1);
+    vtkIdType* offset = offsets->GetPointer(0);
+    offset[0] = 0;
+    for (vtkIdType i = 0; i < nCells; ++i) {
+        offset[i + 1] = offset[i] + elems[i]->NbNodes();
+        types[i] = SMDS_MeshCell::toVtkType(elems[i]->GetEntityType());
+    }
+
+    vtkSmartPointer<vtkIdTypeArray> connectivity = vtkSmartPointer<vtkIdTypeArray>::New();
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 0, 0)
+    connectivity->SetNumberOfValues(offset[nCells]);
+#else
+    // legacy layout, every cell is preceded by its number of points
+    connectivity->SetNumberOfValues(offset[nCells] + nCells);
+#endif
+    vtkIdType* conn = connectivity->GetPointer(0);
+    // SMESH reads the element nodes through its own vtk grid, which is not safe to do from
+    // several threads, so this stays sequential
+    for (vtkIdType i = 0; i < nCells; ++i) {
+        const SMDS_MeshElement* elem = elems[i];
+        const int nNodes = elem->NbNodes();
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 0, 0)
+        vtkIdType* ids = conn + offset[i];
+#else
+        vtkIdType* ids = conn + offset[i] + i;
+        *ids++ = nNodes;
+#endif
+        const std::vector<int>& order = SMDS_MeshCell::toVtkOrder(elem->GetEntityType());
+        if (!order.empty()) {
+            for (int j = 0; j < nNodes; ++j) {
+                ids[j] = elem->GetNode(order[j])->GetID() - 1;
+            }
         }
-    }
-    else {
-        for (int i = 0; i < elem->NbNodes(); ++i) {
-            cell->GetPointIds()->SetId(i, elem->GetNode(i)->GetID() - 1);
+        else {
+            for (int j = 0; j < nNodes; ++j) {
+                ids[j] = elem->GetNode(j)->GetID() - 1;
+            }
         }
     }
-    elemArray->InsertNextCell(cell);
-    types.push_back(SMDS_MeshCell::toVtkType(elem->GetEntityType()));
+
+    vtkSmartPointer<vtkCellArray> cells = vtkSmartPointer<vtkCellArray>::New();
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 0, 0)
+    cells->SetData(offsets, connectivity);
+#else
+    cells->SetCells(nCells, connectivity);
+#endif
+    grid->SetCells(types.data(), cells);
 }
 
 // Helper function to fill SMDS_Mesh elements ID from vtk cell
-void fillMeshElementIds(vtkCell* cell, std::vector<int>& ids)
+void fillMeshElementIds(VTKCellType cellType, vtkIdList* pointIds, std::vector<int>& ids)
 {
-    VTKCellType cellType = static_cast<VTKCellType>(cell->GetCellType());
     const std::vector<int>& order = SMDS_MeshCell::fromVtkOrder(cellType);
-    vtkIdType* vtkIds = cell->GetPointIds()->GetPointer(0);
-    ids.clear();
-    int nbPoints = cell->GetNumberOfPoints();
+    vtkIdType* vtkIds = pointIds->GetPointer(0);
+    int nbPoints = pointIds->GetNumberOfIds();
     ids.resize(nbPoints);
     if (!order.empty()) {
         for (int i = 0; i < nbPoints; ++i) {
@@ -161,15 +216,19 @@ void FemVTKTools::importVTKMesh(vtkSmartPointer<vtkDataSet> dataset, FemMesh* me
     meshds->ClearMesh();
 
     for (vtkIdType i = 0; i < nPoints; i++) {
-        double* p = dataset->GetPoint(i);
+        double p[3];
+        dataset->GetPoint(i, p);
         meshds->AddNodeWithID(p[0] * scale, p[1] * scale, p[2] * scale, i + 1);
     }
 
+    // query the point ids directly, GetCell() would build a cell object with its coordinates
+    vtkNew<vtkIdList> pointIds;
+    std::vector<int> ids;
     for (vtkIdType iCell = 0; iCell < nCells; iCell++) {
-        vtkCell* cell = dataset->GetCell(iCell);
-        std::vector<int> ids;
-        fillMeshElementIds(cell, ids);
-        switch (cell->GetCellType()) {
+        const int cellType = dataset->GetCellType(iCell);
+        dataset->GetCellPoints(iCell, pointIds);
+        fillMeshElementIds(static_cast<VTKCellType>(cellType), pointIds, ids);
+        switch (cellType) {
             // 1D edges
             case VTK_LINE:  // seg2
                 meshds->AddEdgeWithID(ids[0], ids[1], iCell + 1);
@@ -341,97 +400,68 @@ FemMesh* FemVTKTools::readVTKMesh(const char* filename, FemMesh* mesh)
     return mesh;
 }
 
-void exportFemMeshEdges(vtkSmartPointer<vtkCellArray>& elemArray,
-                        std::vector<int>& types,
+void exportFemMeshEdges(std::vector<const SMDS_MeshElement*>& elems,
                         const SMDS_EdgeIteratorPtr& aEdgeIter)
 {
     Base::Console().log("  Start: VTK mesh builder edges.\n");
 
     while (aEdgeIter->more()) {
         const SMDS_MeshEdge* aEdge = aEdgeIter->next();
-        // edge
-        if (aEdge->GetEntityType() == SMDSEntity_Edge) {
-            fillVtkArray<vtkLine>(elemArray, types, aEdge);
-        }
-        // quadratic edge
-        else if (aEdge->GetEntityType() == SMDSEntity_Quad_Edge) {
-            fillVtkArray<vtkQuadraticEdge>(elemArray, types, aEdge);
-        }
-        else {
-            throw Base::TypeError("Edge not yet supported by FreeCAD's VTK mesh builder\n");
+        switch (aEdge->GetEntityType()) {
+            case SMDSEntity_Edge:       // edge
+            case SMDSEntity_Quad_Edge:  // quadratic edge
+                elems.push_back(aEdge);
+                break;
+            default:
+                throw Base::TypeError("Edge not yet supported by FreeCAD's VTK mesh builder\n");
         }
     }
 
     Base::Console().log("  End: VTK mesh builder edges.\n");
 }
 
-void exportFemMeshFaces(vtkSmartPointer<vtkCellArray>& elemArray,
-                        std::vector<int>& types,
+void exportFemMeshFaces(std::vector<const SMDS_MeshElement*>& elems,
                         const SMDS_FaceIteratorPtr& aFaceIter)
 {
     Base::Console().log("  Start: VTK mesh builder faces.\n");
 
     while (aFaceIter->more()) {
         const SMDS_MeshFace* aFace = aFaceIter->next();
-        // triangle
-        if (aFace->GetEntityType() == SMDSEntity_Triangle) {
-            fillVtkArray<vtkTriangle>(elemArray, types, aFace);
-        }
-        // quad
-        else if (aFace->GetEntityType() == SMDSEntity_Quadrangle) {
-            fillVtkArray<vtkQuad>(elemArray, types, aFace);
-        }
-        // quadratic triangle
-        else if (aFace->GetEntityType() == SMDSEntity_Quad_Triangle) {
-            fillVtkArray<vtkQuadraticTriangle>(elemArray, types, aFace);
-        }
-        // quadratic quad
-        else if (aFace->GetEntityType() == SMDSEntity_Quad_Quadrangle) {
-            fillVtkArray<vtkQuadraticQuad>(elemArray, types, aFace);
-        }
-        else {
-            throw Base::TypeError("Face not yet supported by FreeCAD's VTK mesh builder\n");
+        switch (aFace->GetEntityType()) {
+            case SMDSEntity_Triangle:         // triangle
+            case SMDSEntity_Quadrangle:       // quad
+            case SMDSEntity_Quad_Triangle:    // quadratic triangle
+            case SMDSEntity_Quad_Quadrangle:  // quadratic quad
+                elems.push_back(aFace);
+                break;
+            default:
+                throw Base::TypeError("Face not yet supported by FreeCAD's VTK mesh builder\n");
         }
     }
 
     Base::Console().log("  End: VTK mesh builder faces.\n");
 }
 
-void exportFemMeshCells(vtkSmartPointer<vtkCellArray>& elemArray,
-                        std::vector<int>& types,
+void exportFemMeshCells(std::vector<const SMDS_MeshElement*>& elems,
                         const SMDS_VolumeIteratorPtr& aVolIter)
 {
     Base::Console().log("  Start: VTK mesh builder volumes.\n");
 
     while (aVolIter->more()) {
         const SMDS_MeshVolume* aVol = aVolIter->next();
-
-        if (aVol->GetEntityType() == SMDSEntity_Tetra) {  // tetra4
-            fillVtkArray<vtkTetra>(elemArray, types, aVol);
-        }
-        else if (aVol->GetEntityType() == SMDSEntity_Pyramid) {  // pyra5
-            fillVtkArray<vtkPyramid>(elemArray, types, aVol);
-        }
-        else if (aVol->GetEntityType() == SMDSEntity_Penta) {  // penta6
-            fillVtkArray<vtkWedge>(elemArray, types, aVol);
-        }
-        else if (aVol->GetEntityType() == SMDSEntity_Hexa) {  // hexa8
-            fillVtkArray<vtkHexahedron>(elemArray, types, aVol);
-        }
-        else if (aVol->GetEntityType() == SMDSEntity_Quad_Tetra) {  // tetra10
-            fillVtkArray<vtkQuadraticTetra>(elemArray, types, aVol);
-        }
-        else if (aVol->GetEntityType() == SMDSEntity_Quad_Pyramid) {  // pyra13
-            fillVtkArray<vtkQuadraticPyramid>(elemArray, types, aVol);
-        }
-        else if (aVol->GetEntityType() == SMDSEntity_Quad_Penta) {  // penta15
-            fillVtkArray<vtkQuadraticWedge>(elemArray, types, aVol);
-        }
-        else if (aVol->GetEntityType() == SMDSEntity_Quad_Hexa) {  // hexa20
-            fillVtkArray<vtkQuadraticHexahedron>(elemArray, types, aVol);
-        }
-        else {
-            throw Base::TypeError("Volume not yet supported by FreeCAD's VTK mesh builder\n");
+        switch (aVol->GetEntityType()) {
+            case SMDSEntity_Tetra:         // tetra4
+            case SMDSEntity_Pyramid:       // pyra5
+            case SMDSEntity_Penta:         // penta6
+            case SMDSEntity_Hexa:          // hexa8
+            case SMDSEntity_Quad_Tetra:    // tetra10
+            case SMDSEntity_Quad_Pyramid:  // pyra13
+            case SMDSEntity_Quad_Penta:    // penta15
+            case SMDSEntity_Quad_Hexa:     // hexa20
+                elems.push_back(aVol);
+                break;
+            default:
+                throw Base::TypeError("Volume not yet supported by FreeCAD's VTK mesh builder\n");
         }
     }
 
@@ -451,20 +481,32 @@ void FemVTKTools::exportVTKMesh(const FemMesh* mesh,
     // nodes
     Base::Console().log("  Start: VTK mesh builder nodes.\n");
 
+    // memory is allocated by VTK points size for max node id, not for point count
+    // if the SMESH mesh has gaps in node numbering, points without any element
+    // assignment will be inserted in these point gaps too
+    // this needs to be taken into account on node mapping when FreeCAD FEM results
+    // are exported to vtk
+    const vtkIdType maxId = meshDS->NbNodes() > 0 ? meshDS->MaxNodeID() : 0;
     vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+    std::vector<const SMDS_MeshNode*> nodes;
+    nodes.reserve(meshDS->NbNodes());
     SMDS_NodeIteratorPtr aNodeIter = meshDS->nodesIterator();
-
     while (aNodeIter->more()) {
-        const SMDS_MeshNode* node = aNodeIter->next();  // why float, not double?
-        double coords[3] = {double(node->X() * scale),
-                            double(node->Y() * scale),
-                            double(node->Z() * scale)};
-        points->InsertPoint(node->GetID() - 1, coords);
-        // memory is allocated by VTK points size for max node id, not for point count
-        // if the SMESH mesh has gaps in node numbering, points without any element
-        // assignment will be inserted in these point gaps too
-        // this needs to be taken into account on node mapping when FreeCAD FEM results
-        // are exported to vtk
+        nodes.push_back(aNodeIter->next());
+    }
+
+    points->SetNumberOfPoints(maxId);
+    vtkDataArray* data = points->GetData();
+    data->Fill(0.0);
+    // GetXYZ is the thread safe way to read the node coordinates
+#pragma omp parallel for schedule(static)
+    for (long i = 0; i < static_cast<long>(nodes.size()); ++i) {
+        double coords[3];
+        nodes[i]->GetXYZ(coords);
+        coords[0] *= scale;
+        coords[1] *= scale;
+        coords[2] *= scale;
+        data->SetTuple(nodes[i]->GetID() - 1, coords);
     }
     grid->SetPoints(points);
     // nodes debugging
@@ -474,39 +516,38 @@ void FemVTKTools::exportVTKMesh(const FemMesh* mesh,
     Base::Console().log("    Size of nodes in VTK grid: %i.\n", nNodes);
     Base::Console().log("  End: VTK mesh builder nodes.\n");
 
-    vtkSmartPointer<vtkCellArray> elemArray = vtkSmartPointer<vtkCellArray>::New();
-    std::vector<int> types;
+    std::vector<const SMDS_MeshElement*> elems;
 
     if (highest) {
         // try volumes
         SMDS_VolumeIteratorPtr aVolIter = meshDS->volumesIterator();
-        exportFemMeshCells(elemArray, types, aVolIter);
+        exportFemMeshCells(elems, aVolIter);
         // try faces
-        if (elemArray->GetNumberOfCells() == 0) {
+        if (elems.empty()) {
             SMDS_FaceIteratorPtr aFaceIter = meshDS->facesIterator();
-            exportFemMeshFaces(elemArray, types, aFaceIter);
+            exportFemMeshFaces(elems, aFaceIter);
         }
         // try edges
-        if (elemArray->GetNumberOfCells() == 0) {
+        if (elems.empty()) {
             SMDS_EdgeIteratorPtr aEdgeIter = meshDS->edgesIterator();
-            exportFemMeshEdges(elemArray, types, aEdgeIter);
+            exportFemMeshEdges(elems, aEdgeIter);
         }
     }
     else {
         // export all elements
         // edges
         SMDS_EdgeIteratorPtr aEdgeIter = meshDS->edgesIterator();
-        exportFemMeshEdges(elemArray, types, aEdgeIter);
+        exportFemMeshEdges(elems, aEdgeIter);
         // faces
         SMDS_FaceIteratorPtr aFaceIter = meshDS->facesIterator();
-        exportFemMeshFaces(elemArray, types, aFaceIter);
+        exportFemMeshFaces(elems, aFaceIter);
         // volumes
         SMDS_VolumeIteratorPtr aVolIter = meshDS->volumesIterator();
-        exportFemMeshCells(elemArray, types, aVolIter);
+        exportFemMeshCells(elems, aVolIter);
     }
 
-    if (elemArray->GetNumberOfCells() > 0) {
-        grid->SetCells(types.data(), elemArray);
+    if (!elems.empty()) {
+        setGridCells(grid, elems);
     }
 
     Base::Console().log("End: VTK mesh builder ======================\n");
@@ -1107,108 +1148,266 @@ std::map<int, std::vector<int>> mapCcxToVtk = {
     {VTK_WEDGE, {0, 1, 2, 3, 4, 5}},
     {VTK_QUADRATIC_WEDGE, {0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 13, 14, 9, 10, 11}}};
 
-// give position of first non-blank character of string_view
-size_t getFirstNotBlankPos(const std::string_view& view)
+// vtk cell type of the CalculiX element types
+std::map<ElementType, int> mapCcxTypeToVtk = {
+    {ElementType::Edge, VTK_LINE},
+    {ElementType::QuadEdge, VTK_QUADRATIC_EDGE},
+    {ElementType::Triangle, VTK_TRIANGLE},
+    {ElementType::QuadTriangle, VTK_QUADRATIC_TRIANGLE},
+    {ElementType::Quadrangle, VTK_QUAD},
+    {ElementType::QuadQuadrangle, VTK_QUADRATIC_QUAD},
+    {ElementType::Tetra, VTK_TETRA},
+    {ElementType::QuadTetra, VTK_QUADRATIC_TETRA},
+    {ElementType::Hexa, VTK_HEXAHEDRON},
+    {ElementType::QuadHexa, VTK_QUADRATIC_HEXAHEDRON},
+    {ElementType::Penta, VTK_WEDGE},
+    {ElementType::QuadPenta, VTK_QUADRATIC_WEDGE},
+};
+
+// read only view of a whole file. The file is memory mapped, if that fails it is read into
+// memory
+class FRDFile
+{
+public:
+    explicit FRDFile(const Base::FileInfo& fi)
+    {
+#if defined(FC_OS_WIN32)
+        file = CreateFileW(fi.toStdWString().c_str(),
+                           GENERIC_READ,
+                           FILE_SHARE_READ,
+                           nullptr,
+                           OPEN_EXISTING,
+                           FILE_ATTRIBUTE_NORMAL,
+                           nullptr);
+        LARGE_INTEGER size;
+        if (file != INVALID_HANDLE_VALUE && GetFileSizeEx(file, &size) && size.QuadPart > 0) {
+            mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (mapping) {
+                map = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                length = static_cast<size_t>(size.QuadPart);
+            }
+        }
+#else
+        fd = ::open(fi.filePath().c_str(), O_RDONLY);
+        struct stat st;
+        if (fd >= 0 && ::fstat(fd, &st) == 0 && st.st_size > 0) {
+            map = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map == MAP_FAILED) {
+                map = nullptr;
+            }
+            else {
+                length = static_cast<size_t>(st.st_size);
+            }
+        }
+#endif
+        if (map) {
+            first = static_cast<const char*>(map);
+        }
+        else {
+            Base::ifstream str(fi, std::ios::in | std::ios::binary);
+            buffer.assign(std::istreambuf_iterator<char>(str), std::istreambuf_iterator<char>());
+            first = buffer.data();
+            length = buffer.size();
+        }
+    }
+    ~FRDFile()
+    {
+#if defined(FC_OS_WIN32)
+        if (map) {
+            UnmapViewOfFile(map);
+        }
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        if (file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file);
+        }
+#else
+        if (map) {
+            ::munmap(map, length);
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+#endif
+    }
+    FRDFile(const FRDFile&) = delete;
+    FRDFile& operator=(const FRDFile&) = delete;
+
+    const char* begin() const
+    {
+        return first;
+    }
+    const char* end() const
+    {
+        return first + length;
+    }
+
+private:
+    const char* first {nullptr};
+    size_t length {0};
+    void* map {nullptr};
+    std::string buffer;
+#if defined(FC_OS_WIN32)
+    HANDLE file {INVALID_HANDLE_VALUE};
+    HANDLE mapping {nullptr};
+#else
+    int fd {-1};
+#endif
+};
+
+// split text into lines without copying it, a trailing '\r' is removed
+class LineReader
 {
-    size_t pos = view.find_first_not_of(" ");
-    if (pos == std::string_view::npos) {
-        pos = 0;
+public:
+    LineReader(const char* begin, const char* end)
+        : pos(begin)
+        , last(end)
+    {}
+
+    bool next(std::string_view& line)
+    {
+        if (pos >= last) {
+            return false;
+        }
+        auto eol = static_cast<const char*>(std::memchr(pos, '\n', last - pos));
+        const char* stop = eol ? eol : last;
+        line = std::string_view(pos, stop - pos);
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        pos = eol ? eol + 1 : last;
+        return true;
+    }
+    const char* position() const
+    {
+        return pos;
     }
 
-    return pos;
-}
+private:
+    const char* pos;
+    const char* last;
+};
 
-// get n-digits value from string_view
-// not used until libc++ std::from_chars supports double values
-// template<typename T>
-// void valueFromLine(const std::string_view::const_iterator& it, int digits, T& value)
-//{
-//    std::string_view sub(it, digits);
-//    auto pos = getFirstNotBlankPos(sub);
-//    std::from_chars(sub.data() + pos, sub.data() + digits, value, 10);
-//}
+// get integer value from the fixed width field of a line
 template<typename T>
-void valueFromLine(const std::string_view::iterator& it, int digits, T& value)
+T intField(std::string_view line, size_t pos, size_t width)
 {
-    std::string_view sub(&*it, digits);
-    value = std::strtol(sub.data(), nullptr, 10);
+    T value {0};
+    if (pos < line.size()) {
+        std::string_view field = line.substr(pos, width);
+        size_t first = field.find_first_not_of(' ');
+        if (first != std::string_view::npos) {
+            std::from_chars(field.data() + first, field.data() + field.size(), value);
+        }
+    }
+    return value;
 }
-template<>
-void valueFromLine<double>(const std::string_view::iterator& it, int digits, double& value)
+
+// get floating point value from the fixed width field of a line
+// std::from_chars is not used until libc++ supports double values
+double doubleField(std::string_view line, size_t pos, size_t width)
 {
-    std::string_view sub(&*it, digits);
-    value = std::strtof(sub.data(), nullptr);
+    if (pos >= line.size()) {
+        return 0.0;
+    }
+    char buffer[32];
+    std::string_view field = line.substr(pos, std::min(width, sizeof(buffer) - 1));
+    std::memcpy(buffer, field.data(), field.size());
+    buffer[field.size()] = '\0';
+    return std::strtod(buffer, nullptr);
 }
 
-// add cell from sorted nodes
-template<typename T>
-void addCell(vtkSmartPointer<vtkCellArray>& cellArray, const std::vector<int>& topoElem)
+// get text from the fixed width field of a line without trailing spaces
+std::string textField(std::string_view line, size_t pos, size_t width)
 {
-    vtkSmartPointer<T> cell = vtkSmartPointer<T>::New();
-    cell->GetPointIds()->SetNumberOfIds(topoElem.size());
-    int type = cell->GetCellType();
-    for (size_t i = 0; i < topoElem.size(); ++i) {
-        cell->GetPointIds()->SetId(i, topoElem[mapCcxToVtk[type][i]]);
+    if (pos >= line.size()) {
+        return {};
     }
-    cellArray->InsertNextCell(cell);
+    std::string text {line.substr(pos, width)};
+    text.erase(text.find_last_not_of(' ') + 1);
+    return text;
 }
 
-// fill cell array
-void fillCell(vtkSmartPointer<vtkCellArray>& cellArray,
-              std::vector<int>& topoElem,
-              std::vector<int>& vtkType,
-              ElementType elemType)
+enum class BlockType
 {
-    switch (elemType) {
-        case ElementType::Hexa:
-            addCell<vtkHexahedron>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_HEXAHEDRON);
-            break;
-        case ElementType::Penta:
-            addCell<vtkWedge>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_WEDGE);
-            break;
-        case ElementType::Tetra:
-            addCell<vtkTetra>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_TETRA);
-            break;
-        case ElementType::QuadHexa:
-            addCell<vtkQuadraticHexahedron>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_QUADRATIC_HEXAHEDRON);
-            break;
-        case ElementType::QuadPenta:
-            addCell<vtkQuadraticWedge>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_QUADRATIC_WEDGE);
-            break;
-        case ElementType::QuadTetra:
-            addCell<vtkQuadraticTetra>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_QUADRATIC_TETRA);
-            break;
-        case ElementType::Triangle:
-            addCell<vtkTriangle>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_TRIANGLE);
-            break;
-        case ElementType::QuadTriangle:
-            addCell<vtkQuadraticTriangle>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_QUADRATIC_TRIANGLE);
-            break;
-        case ElementType::Quadrangle:
-            addCell<vtkQuad>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_QUAD);
-            break;
-        case ElementType::QuadQuadrangle:
-            addCell<vtkQuadraticQuad>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_QUADRATIC_QUAD);
-            break;
-        case ElementType::Edge:
-            addCell<vtkLine>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_LINE);
-            break;
-        case ElementType::QuadEdge:
-            addCell<vtkQuadraticEdge>(cellArray, topoElem);
-            vtkType.emplace_back(VTK_QUADRATIC_EDGE);
-            break;
+    Nodes,
+    Elements,
+    Results
+};
+
+// position of a data block in the file
+struct FRDBlock
+{
+    BlockType type;
+    std::string_view header;
+    // block lines between the header and the " -3" end line
+    const char* begin;
+    const char* end;
+};
+
+// find the node, element and nodal result blocks of the file
+std::vector<FRDBlock> indexBlocks(const char* begin, const char* end)
+{
+    std::vector<FRDBlock> blocks;
+    LineReader reader(begin, end);
+    std::string_view line;
+    while (reader.next(line)) {
+        BlockType type;
+        if (line.starts_with("    2C")) {
+            type = BlockType::Nodes;
+        }
+        else if (line.starts_with("    3C")) {
+            type = BlockType::Elements;
+        }
+        else if (line.starts_with("  100C")) {
+            type = BlockType::Results;
+        }
+        else {
+            // parameter headers ("    1P") are not used
+            continue;
+        }
+
+        FRDBlock block {type, line, reader.position(), end};
+        const char* lineStart = reader.position();
+        while (reader.next(line)) {
+            if (line.starts_with(" -3")) {
+                block.end = lineStart;
+                break;
+            }
+            lineStart = reader.position();
+        }
+        blocks.push_back(block);
     }
+
+    return blocks;
+}
+
+// lines of a block
+std::vector<std::string_view> blockLines(const FRDBlock& block)
+{
+    std::vector<std::string_view> lines;
+    LineReader reader(block.begin, block.end);
+    std::string_view line;
+    while (reader.next(line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+// indices of the lines that start a record, followed by the number of lines
+std::vector<size_t> recordStarts(const std::vector<std::string_view>& lines,
+                                 size_t first,
+                                 std::string_view keyCode)
+{
+    std::vector<size_t> starts;
+    for (size_t i = first; i < lines.size(); ++i) {
+        if (lines[i].starts_with(keyCode)) {
+            starts.push_back(i);
+        }
+    }
+    starts.push_back(lines.size());
+    return starts;
 }
 
 struct FRDResultInfo
@@ -1269,201 +1468,199 @@ std::vector<size_t> identifyScalarEntities(const std::vector<std::vector<int>> e
     return pos;
 }
 
-// read nodes and fill vtkPoints object
-std::map<int, int>
-readNodes(std::ifstream& ifstr, const std::string& lines, vtkSmartPointer<vtkPoints>& points)
+struct FRDNodes
 {
-    std::string keyCode = "    2C";
-    std::string keyCodeCoord = " -1";
-    long numNodes {0};
-    int indicator {0};
-    int node {0};
-    long nodeID = 0;
-
+    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
     // frd file might have nodes that are not numbered starting from zero.
-    // Use the map to identify them
-    std::map<int, int> mapNodes;
-
-    std::string_view view {lines};
-    std::string_view sub = view.substr(keyCode.length() + 18);
-
-    valueFromLine(sub.begin(), 12, numNodes);
-
-    sub = sub.substr(12 + 37);
-    valueFromLine(sub.begin(), 1, indicator);
-    int digits = getDigits(static_cast<Indicator>(indicator));
-
-    points->SetNumberOfPoints(numNodes);
-
-    std::string line;
-    while (nodeID < numNodes && std::getline(ifstr, line)) {
-        std::vector<double> coords;
-        std::string_view view {line};
-        if (view.rfind(keyCodeCoord, 0) == 0) {
-            std::string_view v(line.data() + keyCodeCoord.length(), digits);
-            valueFromLine(v.begin(), digits, node);
+    // Point index of each node number, -1 for unused numbers
+    std::vector<vtkIdType> index;
 
-            std::string_view vi = view.substr(keyCodeCoord.length() + digits);
-            double value;
-            for (auto it = vi.begin(); it != vi.end(); it += 12) {
-                valueFromLine(it, 12, value);
-                coords.emplace_back(value);
-            }
+    vtkIdType find(long node) const
+    {
+        if (node < 0 || node >= static_cast<long>(index.size())) {
+            return -1;
         }
+        return index[node];
+    }
+};
 
-        points->SetPoint(nodeID, coords.data());
-        mapNodes[node] = nodeID++;
+// read nodes block and fill vtkPoints object
+void readNodes(const FRDBlock& block, FRDNodes& nodes)
+{
+    int digits = getDigits(static_cast<Indicator>(intField<int>(block.header, 73, 1)));
+
+    std::vector<std::string_view> lines = blockLines(block);
+    std::erase_if(lines, [](std::string_view line) {
+        return !line.starts_with(" -1");
+    });
+
+    const long numNodes = static_cast<long>(lines.size());
+    std::vector<long> ids(numNodes);
+    nodes.points->SetNumberOfPoints(numNodes);
+    vtkDataArray* data = nodes.points->GetData();
+#pragma omp parallel for schedule(static)
+    for (long i = 0; i < numNodes; ++i) {
+        ids[i] = intField<long>(lines[i], 3, digits);
+        double coords[3];
+        for (int j = 0; j < 3; ++j) {
+            coords[j] = doubleField(lines[i], 3 + digits + 12 * j, 12);
+        }
+        data->SetTuple(i, coords);
     }
 
-    return mapNodes;
+    long maxId = ids.empty() ? -1 : *std::ranges::max_element(ids);
+    nodes.index.assign(maxId + 1, -1);
+    for (long i = 0; i < numNodes; ++i) {
+        if (ids[i] >= 0) {
+            nodes.index[ids[i]] = i;
+        }
+    }
 }
 
-// fill elements and fill cell array
-std::vector<int> readElements(std::ifstream& ifstr,
-                              const std::string& lines,
-                              const std::map<int, int>& mapNodes,
-                              vtkSmartPointer<vtkCellArray>& cellArray)
+// read elements block and fill cell array
+std::vector<int>
+readElements(const FRDBlock& block, const FRDNodes& nodes, vtkSmartPointer<vtkCellArray>& cellArray)
 {
-    std::string line;
-    std::string keyCode = "    3C";
-    std::string keyCodeType = " -1";
-    std::string keyCodeNodes = " -2";
-    long numElem;
-    int indicator;
-    int elem;
-    long elemID = 0;
-    // element info: {type, group, material}
-    std::vector<int> info(3);
-    std::map<int, int> mapElem;
-    std::vector<int> topoElem;
+    int digits = getDigits(static_cast<Indicator>(intField<int>(block.header, 73, 1)));
+
+    // each element starts with a " -1" line holding its type, followed by " -2" lines with its
+    // nodes
+    std::vector<std::string_view> lines = blockLines(block);
+    std::vector<size_t> starts = recordStarts(lines, 0, " -1");
+    const long numElem = static_cast<long>(starts.size()) - 1;
+
+    std::vector<int> elemTypes(numElem);
+    std::vector<int> elemSizes(numElem);
+#pragma omp parallel for schedule(static)
+    for (long i = 0; i < numElem; ++i) {
+        auto type = static_cast<ElementType>(intField<int>(lines[starts[i]], 3 + digits, 5));
+        auto it = mapCcxTypeToVtk.find(type);
+        // skip unknown element types
+        if (it != mapCcxTypeToVtk.end()) {
+            elemTypes[i] = it->second;
+            elemSizes[i] = static_cast<int>(mapCcxTypeNodes.at(type));
+        }
+    }
+
     std::vector<int> vtkType;
+    std::vector<long> cellElems;
+    for (long i = 0; i < numElem; ++i) {
+        if (elemSizes[i] > 0) {
+            vtkType.push_back(elemTypes[i]);
+            cellElems.push_back(i);
+        }
+    }
 
-    std::string_view view {lines};
-
-    std::string_view sub = view.substr(keyCode.length() + 18);
-    valueFromLine(sub.begin(), 12, numElem);
-
-    sub = sub.substr(12 + 37);
-    valueFromLine(sub.begin(), 1, indicator);
-    int digits = getDigits(static_cast<Indicator>(indicator));
-    while (elemID < numElem && std::getline(ifstr, line)) {
-        std::string_view view {line};
-        if (view.rfind(keyCodeType, 0) == 0) {
-            std::string_view v(line.data() + keyCodeType.length());
-            valueFromLine(v.begin(), digits, elem);
-            v = v.substr(digits);
-            std::string_view::iterator it1;
-            std::vector<int>::iterator it2;
-            for (it1 = v.begin(), it2 = info.begin(); it1 != v.end() && it2 != info.end();
-                 it1 += 5, ++it2) {
-                valueFromLine(it1, 5, *it2);
+    const long numCells = static_cast<long>(cellElems.size());
+    vtkSmartPointer<vtkIdTypeArray> offsets = vtkSmartPointer<vtkIdTypeArray>::New();
+    offsets->SetNumberOfValues(numCells + 1);
+    vtkIdType* offset = offsets->GetPointer(0);
+    offset[0] = 0;
+    for (long i = 0; i < numCells; ++i) {
+        offset[i + 1] = offset[i] + elemSizes[cellElems[i]];
+    }
+
+    vtkSmartPointer<vtkIdTypeArray> connectivity = vtkSmartPointer<vtkIdTypeArray>::New();
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 0, 0)
+    connectivity->SetNumberOfValues(offset[numCells]);
+#else
+    // legacy layout, every cell is preceded by its number of points
+    connectivity->SetNumberOfValues(offset[numCells] + numCells);
+#endif
+    vtkIdType* conn = connectivity->GetPointer(0);
+    bool invalid = false;
+#pragma omp parallel for schedule(dynamic, 1024) reduction(|| : invalid)
+    for (long i = 0; i < numCells; ++i) {
+        const long elem = cellElems[i];
+        const int numNodes = elemSizes[elem];
+        // quadratic hexahedron has the most nodes
+        vtkIdType topoElem[20];
+        int count = 0;
+        for (size_t l = starts[elem] + 1; l < starts[elem + 1]; ++l) {
+            std::string_view line = lines[l];
+            if (!line.starts_with(" -2")) {
+                continue;
             }
-        }
-        if (view.rfind(keyCodeNodes, 0) == 0) {
-            std::string_view vi = view.substr(keyCodeNodes.length());
-            int node;
-            for (auto it = vi.begin(); it != vi.end(); it += digits) {
-                valueFromLine(it, digits, node);
-                topoElem.emplace_back(mapNodes.at(node));
+            for (size_t pos = 3; pos < line.size() && count < numNodes; pos += digits) {
+                topoElem[count++] = nodes.find(intField<long>(line, pos, digits));
             }
+        }
+        bool complete = (count == numNodes);
+        for (int j = 0; complete && j < numNodes; ++j) {
+            complete = topoElem[j] >= 0;
+        }
+        if (!complete) {
+            invalid = true;
+            continue;
+        }
 
-            // add cell to cellArray
-            if (topoElem.size() == mapCcxTypeNodes[static_cast<ElementType>(info[0])]) {
-                fillCell(cellArray, topoElem, vtkType, static_cast<ElementType>(info[0]));
-                topoElem.clear();
-                mapElem[elem] = elemID++;
-            }
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 0, 0)
+        vtkIdType* ids = conn + offset[i];
+#else
+        vtkIdType* ids = conn + offset[i] + i;
+        *ids++ = numNodes;
+#endif
+        const std::vector<int>& order = mapCcxToVtk.at(elemTypes[elem]);
+        for (int j = 0; j < numNodes; ++j) {
+            ids[j] = topoElem[order[j]];
         }
     }
-    return vtkType;
-}
+    if (invalid) {
+        throw Base::FileException("File to load not readable");
+    }
 
-// read parameter header (not used)
-void readParameter(std::ifstream& ifstr, const std::string& line)
-{
-    // do nothing
-    (void)ifstr;
-    (void)line;
+#if VTK_VERSION_NUMBER >= VTK_VERSION_CHECK(9, 0, 0)
+    cellArray->SetData(offsets, connectivity);
+#else
+    cellArray->SetCells(numCells, connectivity);
+#endif
+
+    return vtkType;
 }
 
 // read first header from nodal result block
-void readResultInfo(std::ifstream& ifstr, const std::string& lines, FRDResultInfo& info)
+void readResultInfo(std::string_view header, FRDResultInfo& info)
 {
-    (void)ifstr;
-
-    std::string keyCode = "  100C";
-
-    std::string_view view {lines};
-    std::string_view sub = view.substr(keyCode.length() + 6);
-    valueFromLine(sub.begin(), 12, info.value);
-
-    sub = sub.substr(12);
-    valueFromLine(sub.begin(), 12, info.numNodes);
-
-    sub = sub.substr(12 + 20);
-    int anType;
-    valueFromLine(sub.begin(), 2, anType);
-    info.analysisType = static_cast<AnalysisType>(anType);
-
-    sub = sub.substr(2);
-    valueFromLine(sub.begin(), 5, info.step);
-
-    sub = sub.substr(5 + 10);
-    int ind;
-    valueFromLine(sub.begin(), 2, ind);
-    info.indicator = static_cast<Indicator>(ind);
+    info.value = doubleField(header, 12, 12);
+    info.numNodes = intField<long>(header, 24, 12);
+    info.analysisType = static_cast<AnalysisType>(intField<int>(header, 56, 2));
+    info.step = intField<int>(header, 58, 5);
+    info.indicator = static_cast<Indicator>(intField<int>(header, 73, 2));
 }
 
-// read result from nodal result block and add result array to grid
-void readResults(std::ifstream& ifstr,
-                 const std::string& lines,
-                 const std::map<int, int>& mapNodes,
-                 const FRDResultInfo& info,
-                 vtkSmartPointer<vtkUnstructuredGrid>& grid)
+// read result from nodal result block and return the result arrays
+std::vector<vtkSmartPointer<vtkDoubleArray>>
+readResults(const FRDBlock& block, const FRDNodes& nodes, const FRDResultInfo& info)
 {
     int digits = getDigits(info.indicator);
-    (void)lines;
+    std::vector<std::string_view> lines = blockLines(block);
+    if (lines.empty()) {
+        return {};
+    }
 
     // get dataset info, start with " -4"
-    std::string line;
-    std::string keyDataSet = " -4";
-    unsigned int numComps;
-    std::getline(ifstr, line);
-    std::string_view view = line;
-    std::string_view sub = view.substr(keyDataSet.length() + 2);
-    std::string dataSetName {sub.substr(0, 8)};
-    // remove trailing spaces
-    dataSetName.erase(dataSetName.find_last_not_of(" ") + 1);
-    sub = sub.substr(8);
-    valueFromLine(sub.begin(), 5, numComps);
+    std::string dataSetName = textField(lines[0], 5, 8);
+    unsigned int numComps = intField<unsigned int>(lines[0], 13, 5);
 
     // get entity info
-    std::string keyEntity = " -5";
     std::vector<std::string> entityNames;
     // type: 1: scalar; 2: vector; 4: matrix; 12: vector (3 amp - 3 phase); 14: tensor (6 amp - 6
     // phase) {type, row, col, exist}
     std::vector<std::vector<int>> entityTypes;
     unsigned int countComp = 0;
-    while (countComp < numComps && std::getline(ifstr, line)) {
-        std::string_view view {line};
-        if (view.rfind(keyEntity, 0) == 0) {
-            sub = view.substr(keyEntity.length() + 2);
-            std::string en {sub.substr(0, 8)};
-            // remove trailing spaces
-            en.erase(en.find_last_not_of(" ") + 1);
-            std::vector<int> et = {0, 0, 0, 0};
+    size_t first = 1;
+    for (; first < lines.size() && countComp < numComps; ++first) {
+        std::string_view line = lines[first];
+        if (line.starts_with(" -5")) {
             // fill entityType, ignore MENU: "    1"
-            sub = sub.substr(8 + 5, 4 * 5);
-            std::string_view::iterator it1;
-            std::vector<int>::iterator it2;
-            for (it1 = sub.begin(), it2 = et.begin(); it1 != sub.end() && it2 != et.end();
-                 (it1 += 5), ++it2) {
-                valueFromLine(it1, digits, *it2);
+            std::vector<int> et = {0, 0, 0, 0};
+            for (size_t i = 0; i < et.size(); ++i) {
+                et[i] = intField<int>(line, 18 + 5 * i, 5);
             }
 
             if (et[3] == 0) {
                 // ignore predefined entity
-                entityNames.emplace_back(en);
+                entityNames.emplace_back(textField(line, 5, 8));
                 entityTypes.emplace_back(et);
             }
             ++countComp;
@@ -1473,121 +1670,99 @@ void readResults(std::ifstream& ifstr,
     // used components
     numComps = entityNames.size();
 
-    // enter in node values block
-    std::string code1 = " -1";
-    std::string code2 = " -2";
-    int node {-1};
-    double value {0.0};
-    std::vector<double> vecValues;
-    std::vector<double> scaValues;
-    std::vector<int> nodes;
-    int countNodes = 0;
-    size_t countScaPos {0};
     // result block could have both vector/matrix and scalar components
     // save each scalars entity in his own array
     auto scalarPos = identifyScalarEntities(entityTypes);
+    const int numVecComps = static_cast<int>(numComps - scalarPos.size());
+    // target of each component: scalar array index, or -1 and the vector array component
+    std::vector<int> scalarIndex(numComps, -1);
+    std::vector<int> vecComp(numComps, -1);
+    for (size_t i = 0; i < scalarPos.size(); ++i) {
+        scalarIndex[scalarPos[i]] = static_cast<int>(i);
+    }
+    for (unsigned int i = 0, c = 0; i < numComps; ++i) {
+        if (scalarIndex[i] < 0) {
+            vecComp[i] = c++;
+        }
+    }
+
+    const vtkIdType numPoints = nodes.points->GetNumberOfPoints();
+    std::vector<vtkSmartPointer<vtkDoubleArray>> arrays;
     // array for vector entities (if needed)
-    vtkSmartPointer<vtkDoubleArray> vecArray = vtkSmartPointer<vtkDoubleArray>::New();
+    double* vecData = nullptr;
+    if (numVecComps > 0) {
+        vtkSmartPointer<vtkDoubleArray> vecArray = vtkSmartPointer<vtkDoubleArray>::New();
+        vecArray->SetNumberOfComponents(numVecComps);
+        vecArray->SetNumberOfTuples(numPoints);
+        vecArray->SetName(dataSetName.c_str());
+        vecData = vecArray->GetPointer(0);
+        std::fill_n(vecData, numPoints * numVecComps, 0.0);
+        arrays.push_back(vecArray);
+    }
     // arrays for scalar entities (if needed)
-    std::vector<vtkSmartPointer<vtkDoubleArray>> scaArrays;
-    for (size_t i = 0; i < scalarPos.size(); ++i) {
-        scaArrays.emplace_back(vtkSmartPointer<vtkDoubleArray>::New());
-    }
-
-    vecArray->SetNumberOfComponents(numComps - scalarPos.size());
-    vecArray->SetNumberOfTuples(mapNodes.size());
-    vecArray->SetName(dataSetName.c_str());
-    // set all values to zero
-    for (int i = 0; i < vecArray->GetNumberOfComponents(); ++i) {
-        vecArray->FillComponent(i, 0.0);
-    }
-    //    vecArray->Fill(0.0);
-    for (size_t i = 0; i < scaArrays.size(); ++i) {
-        scaArrays[i]->SetNumberOfComponents(1);
-        scaArrays[i]->SetNumberOfTuples(mapNodes.size());
-        std::string name = entityNames[scalarPos[i]];
-        scaArrays[i]->SetName(name.c_str());
-        //        scaArrays[i]->Fill(0.0);
-        for (int j = 0; j < scaArrays[i]->GetNumberOfComponents(); ++j) {
-            scaArrays[i]->FillComponent(j, 0.0);
-        }
-    }
-
-    while (countNodes < info.numNodes && std::getline(ifstr, line)) {
-        std::string_view view {line};
-        if (view.rfind(code1, 0) == 0) {
-            sub = view.substr(code1.length());
-            valueFromLine(sub.begin(), digits, node);
-            // clear values vector for each node result block
-            vecValues.clear();
-            scaValues.clear();
-            countScaPos = 0;
-            try {
-                // result nodes could not exist in .frd file due to element expansion
-                // so mapNodes.at() could throw an exception
-                nodes.emplace_back(mapNodes.at(node));
-                sub = sub.substr(digits);
-                for (auto it = sub.begin(); it != sub.end(); it += 12, ++countScaPos) {
-                    valueFromLine(it, 12, value);
-                    // search if value is scalar or vector/matrix component
-                    auto pos = std::ranges::find(scalarPos, countScaPos);
-                    if (pos == scalarPos.end()) {
-                        vecValues.emplace_back(value);
-                    }
-                    else {
-                        scaValues.emplace_back(value);
-                    }
-                }
-            }
-            catch (const std::out_of_range&) {
-                Base::Console().warning("Invalid node: %d\n", node);
+    std::vector<double*> scaData;
+    for (size_t pos : scalarPos) {
+        vtkSmartPointer<vtkDoubleArray> scaArray = vtkSmartPointer<vtkDoubleArray>::New();
+        scaArray->SetNumberOfComponents(1);
+        scaArray->SetNumberOfTuples(numPoints);
+        scaArray->SetName(entityNames[pos].c_str());
+        scaData.push_back(scaArray->GetPointer(0));
+        std::fill_n(scaData.back(), numPoints, 0.0);
+        arrays.push_back(scaArray);
+    }
+
+    // node values start with a " -1" line, the values that don't fit follow in " -2" lines
+    std::vector<size_t> starts = recordStarts(lines, first, " -1");
+    const long numRecords = static_cast<long>(starts.size()) - 1;
+    std::vector<long> invalidNodes;
+#pragma omp parallel
+    {
+        std::vector<double> values(numComps);
+        std::vector<long> invalid;
+#pragma omp for schedule(dynamic, 1024) nowait
+        for (long r = 0; r < numRecords; ++r) {
+            long node = intField<long>(lines[starts[r]], 3, digits);
+            // result nodes could not exist in .frd file due to element expansion
+            vtkIdType id = nodes.find(node);
+            if (id < 0) {
+                invalid.push_back(node);
+                continue;
             }
-            ++countNodes;
-        }
-        else if (view.rfind(code2, 0) == 0) {
-            sub = view.substr(code2.length() + digits);
-            for (auto it = sub.begin(); it != sub.end(); it += 12) {
-                valueFromLine(it, 12, value);
-                // search if value is scalar or vector/matrix component
-                auto pos = std::ranges::find(scalarPos, countScaPos);
-                if (pos == scalarPos.end()) {
-                    vecValues.emplace_back(value);
+
+            unsigned int count = 0;
+            for (size_t l = starts[r]; l < starts[r + 1] && count < numComps; ++l) {
+                std::string_view line = lines[l];
+                if (l != starts[r] && !line.starts_with(" -2")) {
+                    continue;
                 }
-                else {
-                    scaValues.emplace_back(value);
+                for (size_t pos = 3 + digits; pos < line.size() && count < numComps; pos += 12) {
+                    values[count++] = doubleField(line, pos, 12);
                 }
             }
-        }
-        if ((vecValues.size() + scaValues.size()) == numComps) {
-            if (!vecValues.empty()) {
-                if (node == -1) {
-                    throw Base::FileException("File to load not readable");
-                }
-                vecArray->SetTuple(mapNodes.at(node), vecValues.data());
+            if (count != numComps) {
+                continue;
             }
-            if (!scaValues.empty()) {
-                if (node == -1) {
-                    throw Base::FileException("File to load not readable");
+
+            for (unsigned int i = 0; i < numComps; ++i) {
+                if (scalarIndex[i] < 0) {
+                    vecData[id * numVecComps + vecComp[i]] = values[i];
                 }
-                std::vector<vtkSmartPointer<vtkDoubleArray>>::iterator it1;
-                std::vector<double>::iterator it2;
-                for (it1 = scaArrays.begin(), it2 = scaValues.begin();
-                     it1 != scaArrays.end() && it2 != scaValues.end();
-                     ++it1, ++it2) {
-                    (*it1)->SetTuple1(mapNodes.at(node), *it2);
+                else {
+                    scaData[scalarIndex[i]][id] = values[i];
                 }
             }
         }
+#pragma omp critical
+        invalidNodes.insert(invalidNodes.end(), invalid.begin(), invalid.end());
     }
 
-    // add vecArray only if not all scalars
-    if (numComps != scalarPos.size()) {
-        grid->GetPointData()->AddArray(vecArray);
-    }
-    for (auto& s : scaArrays) {
-        grid->GetPointData()->AddArray(s);
+    for (long node : invalidNodes) {
+        Base::Console().warning("Invalid node: %ld\n", node);
     }
+
+    return arrays;
 }
+
 vtkSmartPointer<vtkStringArray> createTimeInfo(const std::string& type)
 {
     auto timeInfo = vtkSmartPointer<vtkStringArray>::New();
@@ -1608,42 +1783,31 @@ vtkSmartPointer<vtkFloatArray> createTimeValue(const double& value)
     return stepValue;
 }
 
-vtkSmartPointer<vtkMultiBlockDataSet> readFRD(std::ifstream& ifstr)
+vtkSmartPointer<vtkMultiBlockDataSet> readFRD(const char* begin, const char* end)
 {
-    auto points = vtkSmartPointer<vtkPoints>::New();
+    FRDNodes nodes;
     auto cells = vtkSmartPointer<vtkCellArray>::New();
     auto multiBlock = vtkSmartPointer<vtkMultiBlockDataSet>::New();
     vtkSmartPointer<vtkUnstructuredGrid> grid;
     vtkSmartPointer<vtkMultiBlockDataSet> block;
     std::map<FRDResultInfo, vtkSmartPointer<vtkUnstructuredGrid>> grids;
     std::map<AnalysisType, vtkSmartPointer<vtkMultiBlockDataSet>> blocks;
-    std::string line;
-    std::map<int, int> mapNodes;
     std::vector<int> cellTypes;
 
-    while (std::getline(ifstr, line)) {
-        std::string keyCode = "    2C";
-        std::string_view view = line;
-
-        if (view.rfind(keyCode, 0) == 0) {
+    // locate the data blocks first, each block is then parsed in parallel
+    for (const FRDBlock& fileBlock : indexBlocks(begin, end)) {
+        if (fileBlock.type == BlockType::Nodes) {
             // read nodes block
-            mapNodes = readNodes(ifstr, line, points);
+            readNodes(fileBlock, nodes);
         }
-        keyCode = "    3C";
-        if (view.rfind(keyCode, 0) == 0) {
+        else if (fileBlock.type == BlockType::Elements) {
             // read elements block
-            cellTypes = readElements(ifstr, line, mapNodes, cells);
+            cellTypes = readElements(fileBlock, nodes, cells);
         }
-        keyCode = "    1P";
-        if (view.rfind(keyCode, 0) == 0) {
-            // read parameter
-            readParameter(ifstr, line);
-        }
-        keyCode = "  100C";
-        if (view.rfind(keyCode, 0) == 0) {
+        else if (fileBlock.type == BlockType::Results) {
             // read result info block
             FRDResultInfo info;
-            readResultInfo(ifstr, line, info);
+            readResultInfo(fileBlock.header, info);
             auto it = grids.find(info);
             if (it == grids.end()) {
                 // create TimeInfo metadata
@@ -1660,7 +1824,7 @@ vtkSmartPointer<vtkMultiBlockDataSet> readFRD(std::ifstream& ifstr)
                 }
                 // create unstructured grid
                 grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
-                grid->SetPoints(points);
+                grid->SetPoints(nodes.points);
                 grid->SetCells(cellTypes.data(), cells);
 
                 // create TimeValue metadata
@@ -1677,7 +1841,9 @@ vtkSmartPointer<vtkMultiBlockDataSet> readFRD(std::ifstream& ifstr)
                 grid = (*it).second;
             }
             // read result entries and node results
-            readResults(ifstr, line, mapNodes, info, grid);
+            for (auto& array : readResults(fileBlock, nodes, info)) {
+                grid->GetPointData()->AddArray(array);
+            }
         }
     }
     int i = 0;
@@ -1691,7 +1857,7 @@ vtkSmartPointer<vtkMultiBlockDataSet> readFRD(std::ifstream& ifstr)
     if (grids.empty()) {
         block = vtkSmartPointer<vtkMultiBlockDataSet>::New();
         grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
-        grid->SetPoints(points);
+        grid->SetPoints(nodes.points);
         grid->SetCells(cellTypes.data(), cells);
         auto timeInfo = createTimeInfo("");
         auto stepValue = createTimeValue(0);
@@ -1716,9 +1882,9 @@ void FemVTKTools::frdToVTK(const char* filename, bool binary)
         throw Base::FileException("File to load not existing or not readable", filename);
     }
 
-    std::ifstream ifstr(filename, std::ios::in | std::ios::binary);
+    FRDReader::FRDFile file(fi);
 
-    vtkSmartPointer<vtkMultiBlockDataSet> multiBlock = FRDReader::readFRD(ifstr);
+    vtkSmartPointer<vtkMultiBlockDataSet> multiBlock = FRDReader::readFRD(file.begin(), file.end());
 
     std::string dir = fi.dirPath();
 
@@ -192,6 +192,57 @@ class TestMeshCommon(unittest.TestCase):
             f"Problem in test_writeAbaqus_precision, \n{read_node_line}\n{expected}",
         )
 
+    # ********************************************************************************************
+    def test_nodes_by_shape(self):
+        # getNodesBySolid, getNodesByFace and getNodesByEdge reject most nodes with a grid
+        # before measuring the exact distance. Compare them with measuring every node.
+        # The grid cells start at the origin, so the box faces through the origin lie on cell
+        # borders for any cell size. The nodes sit on, just inside the tolerance and just
+        # outside the tolerance of the box faces and of the curved cylinder face.
+        import math
+        import Part
+
+        box = Part.makeBox(10, 10, 10)
+        cylinder = Part.makeCylinder(3, 10, FreeCAD.Vector(20, 0, 0))
+
+        mesh = Fem.FemMesh()
+        node_id = 1
+        box_coords = [-0.5, -1e-4, -1e-8, 0, 1e-8, 1e-4, 0.5, 5, 10 - 1e-8, 10, 10 + 1e-8, 10.5]
+        for x in box_coords:
+            for y in box_coords:
+                for z in box_coords:
+                    mesh.addNode(x, y, z, node_id)
+                    node_id += 1
+        for i in range(48):
+            angle = math.radians(7.5 * i)
+            for radius in [3 - 1e-4, 3 - 1e-8, 3, 3 + 1e-8, 3 + 1e-4]:
+                for z in [0, 1e-8, 5, 10]:
+                    mesh.addNode(
+                        20 + radius * math.cos(angle), radius * math.sin(angle), z, node_id
+                    )
+                    node_id += 1
+
+        def brute_force(shape, limit):
+            return sorted(
+                nid
+                for nid, pos in mesh.Nodes.items()
+                if shape.distToShape(Part.Vertex(pos))[0] < limit
+            )
+
+        curved = [f for f in cylinder.Faces if f.Surface.TypeId == "Part::GeomCylinder"][0]
+        cases = [
+            ("box face", mesh.getNodesByFace, box.Faces[0], box.Faces[0].Tolerance),
+            ("box face", mesh.getNodesByFace, box.Faces[4], box.Faces[4].Tolerance),
+            ("box edge", mesh.getNodesByEdge, box.Edges[0], box.Edges[0].Tolerance),
+            ("cylinder face", mesh.getNodesByFace, curved, curved.Tolerance),
+            ("box solid", mesh.getNodesBySolid, box.Solids[0], box.getTolerance(1)),
+            ("cylinder solid", mesh.getNodesBySolid, cylinder.Solids[0], cylinder.getTolerance(1)),
+        ]
+        for name, method, shape, limit in cases:
+            expected = brute_force(shape, limit)
+            self.assertTrue(expected, f"no nodes on the {name}")
+            self.assertEqual(sorted(method(shape)), expected, f"wrong nodes on the {name}")
+
 
 # ************************************************************************************************
 # ************************************************************************************************
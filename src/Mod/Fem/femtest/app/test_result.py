@@ -191,3 +191,160 @@ class TestResult(unittest.TestCase):
         self.assertEqual(
             disp_abs, expected_dispabs, "Calculated displacement abs are not the expected values."
         )
+
+    # ********************************************************************************************
+    def read_vtk_array(self, parent, name=None):
+        # values of an ascii DataArray of a vtk xml file, one list per tuple
+        for array in parent.findall("DataArray"):
+            if name is None or array.get("Name") == name:
+                values = [float(v) for v in array.text.split()]
+                comps = int(array.get("NumberOfComponents", "1"))
+                return [values[i : i + comps] for i in range(0, len(values), comps)]
+        return None
+
+    # ********************************************************************************************
+    def assert_values_close(self, actual, expected, msg):
+        import math
+
+        self.assertEqual(len(actual), len(expected), msg)
+        for a, e in zip(actual, expected):
+            self.assertTrue(math.isclose(a, e, rel_tol=1e-6, abs_tol=1e-12), f"{msg}: {a} != {e}")
+
+    # ********************************************************************************************
+    def test_frd_to_vtk(self):
+        # Fem.frdToVTK parses the frd file in C++ and writes vtk files, compare them with
+        # the nodes, elements and results read by the python frd reader
+        if "BUILD_FEM_VTK" not in FreeCAD.__cmake__:
+            return
+        import glob
+        import shutil
+        import xml.etree.ElementTree as ET
+
+        import Fem
+        from feminout.importCcxFrdResults import read_frd_result
+
+        for frd_name in ["box_static", "box_frequency"]:
+            tmp_dir = testtools.get_fem_test_tmp_dir("result_frd_to_vtk_" + frd_name)
+            frd_file = join(tmp_dir, frd_name + ".frd")
+            shutil.copyfile(
+                join(testtools.get_fem_test_home_dir(), "calculix", frd_name + ".frd"), frd_file
+            )
+            Fem.frdToVTK(frd_file, False)
+            expected = read_frd_result(frd_file)
+            node_ids = list(expected["Nodes"].keys())
+            expected_elems = [sorted(nodes) for nodes in expected["Tetra10Elem"].values()]
+
+            vtm_files = glob.glob(join(tmp_dir, "*.vtm"))
+            self.assertEqual(len(vtm_files), 1, f"{frd_name}: wrong number of vtm files")
+            grid_files = [
+                join(tmp_dir, dataset.get("file"))
+                for dataset in ET.parse(vtm_files[0]).iter("DataSet")
+            ]
+            self.assertEqual(
+                len(grid_files), len(expected["Results"]), f"{frd_name}: wrong number of steps"
+            )
+
+            for grid_file, result in zip(grid_files, expected["Results"]):
+                piece = ET.parse(grid_file).find(".//Piece")
+
+                # nodes, in the order of the frd file
+                points = self.read_vtk_array(piece.find("Points"))
+                self.assertEqual(len(points), len(node_ids), f"{frd_name}: wrong node count")
+                for point, node in zip(points, node_ids):
+                    self.assert_values_close(point, expected["Nodes"][node], f"node {node}")
+
+                # elements, vtk and the python reader order the nodes differently
+                cells = piece.find("Cells")
+                connectivity = [int(v[0]) for v in self.read_vtk_array(cells, "connectivity")]
+                offsets = [int(v[0]) for v in self.read_vtk_array(cells, "offsets")]
+                types = [int(v[0]) for v in self.read_vtk_array(cells, "types")]
+                self.assertEqual(types, [24] * len(expected_elems), f"{frd_name}: cell types")
+                start = 0
+                elems = []
+                for end in offsets:
+                    elems.append(sorted(node_ids[i] for i in connectivity[start:end]))
+                    start = end
+                self.assertEqual(elems, expected_elems, f"{frd_name}: wrong elements")
+
+                # results, the python reader swaps the last two stress components
+                point_data = piece.find("PointData")
+                disp = self.read_vtk_array(point_data, "DISP")
+                stress = self.read_vtk_array(point_data, "STRESS")
+                for i, node in enumerate(node_ids):
+                    self.assert_values_close(disp[i], result["disp"][node], f"disp {node}")
+                    s = result["stress"][node]
+                    self.assert_values_close(
+                        stress[i], [s[0], s[1], s[2], s[3], s[5], s[4]], f"stress {node}"
+                    )
+
+    # ********************************************************************************************
+    def test_post_frame_cache(self):
+        # post filters keep the outputs of frames shown before. Switching back to a frame must
+        # give the same output, and changing the input of a filter must drop its cached frames.
+        if "BUILD_FEM_VTK" not in FreeCAD.__cmake__:
+            return
+        import glob
+        import xml.etree.ElementTree as ET
+
+        import Fem
+        import ObjectsFem
+
+        # a static result with a second step that has twice the displacement
+        tmp_dir = testtools.get_fem_test_tmp_dir("result_post_frame_cache")
+        frd_in = join(testtools.get_fem_test_home_dir(), "calculix", "box_static.frd")
+        with open(frd_in) as f:
+            lines = f.readlines()
+        start = next(i for i, ln in enumerate(lines) if ln.startswith(" -4  DISP")) - 1
+        end = next(i for i in range(start, len(lines)) if lines[i].startswith(" -3")) + 1
+        step = [lines[start][:12] + " 2.000000000" + lines[start][24:58] + "    2"
+                + lines[start][63:]]
+        for ln in lines[start + 1 : end]:
+            if ln.startswith(" -1"):
+                values = [2 * float(ln[13 + 12 * i : 25 + 12 * i]) for i in range(3)]
+                ln = ln[:13] + "".join(f"{v:12.5E}" for v in values) + "\n"
+            step.append(ln)
+        frd_file = join(tmp_dir, "two_steps.frd")
+        with open(frd_file, "w") as f:
+            f.writelines(lines[:end] + step + lines[end:])
+        Fem.frdToVTK(frd_file, False)
+
+        pipeline = self.document.addObject("Fem::FemPostPipeline", "Pipeline")
+        pipeline.read(glob.glob(join(tmp_dir, "*.vtm"))[0])
+        upstream = ObjectsFem.makePostVtkFilterWarp(self.document, pipeline, "Upstream")
+        downstream = ObjectsFem.makePostVtkFilterWarp(self.document, pipeline, "Downstream")
+        self.document.recompute()
+        for warp in [upstream, downstream]:
+            warp.Vector = "DISP"
+            warp.Factor = 1
+        self.document.recompute()
+
+        def points_range(frame):
+            pipeline.Frame = frame
+            self.document.recompute()
+            file_name = join(tmp_dir, f"frame{frame}.vtu")
+            downstream.writeVTK(file_name)
+            points = ET.parse(file_name).find(".//Points/DataArray")
+            return float(points.get("RangeMax"))
+
+        params = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/Fem/General")
+        old_size = params.GetUnsigned("PostFrameCacheSize", 512)
+        try:
+            params.SetUnsigned("PostFrameCacheSize", 512)
+            first = points_range(0)
+            second = points_range(1)
+            self.assertNotEqual(first, second, "frames have the same output")
+            self.assertEqual(points_range(0), first, "cached frame differs")
+            self.assertEqual(points_range(1), second, "cached frame differs")
+
+            # the input of the downstream filter changes, both frames must be computed again
+            upstream.Factor = 2
+            self.document.recompute()
+            changed = [points_range(0), points_range(1)]
+            self.assertNotEqual(changed[0], first, "cached frame was not invalidated")
+            self.assertNotEqual(changed[1], second, "cached frame was not invalidated")
+
+            # and give the same output as without the cache
+            params.SetUnsigned("PostFrameCacheSize", 0)
+            self.assertEqual([points_range(0), points_range(1)], changed)
+        finally:
+            params.SetUnsigned("PostFrameCacheSize", old_size)
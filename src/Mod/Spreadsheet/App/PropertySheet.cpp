@@ -68,6 +68,8 @@ void PropertySheet::clear()
 
     propertyNameToCellMap.clear();
     cellToPropertyNameMap.clear();
+    cellToDependentCellMap.clear();
+    cellToReferencedCellMap.clear();
     documentObjectToCellMap.clear();
     cellToDocumentObjectMap.clear();
     aliasProp.clear();
@@ -284,6 +286,8 @@ PropertySheet::PropertySheet(const PropertySheet& other)
     , owner(other.owner)
     , propertyNameToCellMap(other.propertyNameToCellMap)
     , cellToPropertyNameMap(other.cellToPropertyNameMap)
+    , cellToDependentCellMap(other.cellToDependentCellMap)
+    , cellToReferencedCellMap(other.cellToReferencedCellMap)
     , documentObjectToCellMap(other.documentObjectToCellMap)
     , cellToDocumentObjectMap(other.cellToDocumentObjectMap)
     , aliasProp(other.aliasProp)
@@ -1380,6 +1384,13 @@ void PropertySheet::addDependencies(CellAddress key)
                 propertyNameToCellMap[propName].insert(key);
                 cellToPropertyNameMap[key].insert(propName);
 
+                if (docObj == owner && !name.empty()) {
+                    CellAddress addr = stringToAddress(name.c_str(), true);
+                    if (addr.isValid()) {
+                        addCellDependency(key, addr);
+                    }
+                }
+
                 // Also an alias?
                 if (!name.empty() && docObj->isDerivedFrom<Sheet>()) {
                     auto other = static_cast<Sheet*>(docObj);
@@ -1392,6 +1403,10 @@ void PropertySheet::addDependencies(CellAddress key)
                         // Insert into maps
                         propertyNameToCellMap[propName].insert(key);
                         cellToPropertyNameMap[key].insert(std::move(propName));
+
+                        if (docObj == owner) {
+                            addCellDependency(key, j->second);
+                        }
                     }
                 }
             }
@@ -1430,6 +1445,26 @@ void PropertySheet::removeDependencies(CellAddress key)
         cellToPropertyNameMap.erase(i1);
     }
 
+    /* Remove from Cell <-> Key maps */
+
+    auto i3 = cellToReferencedCellMap.find(key);
+
+    if (i3 != cellToReferencedCellMap.end()) {
+        for (const auto& addr : i3->second) {
+            auto k = cellToDependentCellMap.find(addr);
+
+            if (k != cellToDependentCellMap.end()) {
+                k->second.erase(key);
+
+                if (k->second.empty()) {
+                    cellToDependentCellMap.erase(k);
+                }
+            }
+        }
+
+        cellToReferencedCellMap.erase(i3);
+    }
+
     /* Remove from DocumentObject <-> Key maps */
 
     std::map<CellAddress, std::set<std::string>>::iterator i2 = cellToDocumentObjectMap.find(key);
@@ -1635,6 +1670,25 @@ const std::set<CellAddress>& PropertySheet::getDeps(const std::string& name) con
     }
 }
 
+void PropertySheet::addCellDependency(CellAddress key, CellAddress addr)
+{
+    cellToDependentCellMap[addr].insert(key);
+    cellToReferencedCellMap[key].insert(addr);
+}
+
+const std::set<CellAddress>& PropertySheet::getDependentCells(CellAddress pos) const
+{
+    static std::set<CellAddress> empty;
+    auto i = cellToDependentCellMap.find(pos);
+
+    if (i != cellToDependentCellMap.end()) {
+        return i->second;
+    }
+    else {
+        return empty;
+    }
+}
+
 const std::set<std::string>& PropertySheet::getDeps(CellAddress pos) const
 {
     static std::set<std::string> empty;
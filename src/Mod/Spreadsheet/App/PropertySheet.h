@@ -209,6 +209,9 @@ public:
 
     const std::set<std::string>& getDeps(App::CellAddress pos) const;
 
+    /// Cells of this sheet that reference the cell at \a pos, directly or by its alias
+    const std::set<App::CellAddress>& getDependentCells(App::CellAddress pos) const;
+
     void recomputeDependencies(App::CellAddress key);
 
     PyObject* getPyObject() override;
@@ -323,6 +326,16 @@ private:
     /*! Properties this cell depends on */
     std::map<App::CellAddress, std::set<std::string>> cellToPropertyNameMap;
 
+    /*! Same as propertyNameToCellMap, restricted to cells of this sheet and keyed by
+      address, so that the recompute order can be found without building names.
+      */
+    std::map<App::CellAddress, std::set<App::CellAddress>> cellToDependentCellMap;
+
+    /*! Cells of this sheet this cell depends on */
+    std::map<App::CellAddress, std::set<App::CellAddress>> cellToReferencedCellMap;
+
+    void addCellDependency(App::CellAddress key, App::CellAddress addr);
+
     /*! Cell dependencies, i.e when a change occurs to documentObject given in key,
       the set of addresses needs to be recomputed.
       */
@@ -1070,7 +1070,7 @@ DocumentObjectExecReturn* Sheet::execute()
         }
 
         // Process cells that depend on the current cell
-        for (auto& dep : providesTo(currPos)) {
+        for (auto& dep : cells.getDependentCells(currPos)) {
             auto resDep = VertexList.emplace(dep, Vertex());
             if (resDep.second) {
                 resDep.first->second = add_vertex(graph);
@@ -1131,7 +1131,7 @@ DocumentObjectExecReturn* Sheet::execute()
                 }
 
                 // Process cells that depend on the current cell
-                for (auto& dep : providesTo(currPos)) {
+                for (auto& dep : cells.getDependentCells(currPos)) {
                     auto resDep = VertexList.emplace(dep, Vertex());
                     if (resDep.second) {
                         resDep.first->second = add_vertex(graph);
@@ -1625,9 +1625,8 @@ std::set<std::string> Sheet::dependsOn(CellAddress address) const
 void Sheet::providesTo(CellAddress address, std::set<std::string>& result) const
 {
     std::string fullName = getFullName() + ".";
-    std::set<CellAddress> tmpResult = cells.getDeps(fullName + address.toString());
 
-    for (const auto& i : tmpResult) {
+    for (const auto& i : cells.getDependentCells(address)) {
         result.insert(fullName + i.toString());
     }
 }
@@ -1640,7 +1639,7 @@ void Sheet::providesTo(CellAddress address, std::set<std::string>& result) const
 
 std::set<CellAddress> Sheet::providesTo(CellAddress address) const
 {
-    return cells.getDeps(getFullName() + "." + address.toString());
+    return cells.getDependentCells(address);
 }
 
 void Sheet::onDocumentRestored()
@@ -32,13 +32,18 @@
 # include <TopoDS_Wire.hxx>
 
 
+#include <exception>
 #include <boost_regex.hpp>
+#include <QtConcurrentMap>
 
 #include <App/DocumentObject.h>
 #include <App/DocumentObjectPy.h>
 #include <Base/Console.h>
 #include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Interpreter.h>
 #include <Base/PyWrapParseTupleAndKeywords.h>
+#include <Base/Stream.h>
 #include <Base/Vector3D.h>
 #include <Base/VectorPy.h>
 
@@ -144,6 +149,14 @@ public:
         add_varargs_method("writeDXFPage", &Module::writeDXFPage,
             "writeDXFPage(page, filename): Exports a DrawPage to a DXF file."
         );
+        add_varargs_method("writeSVGPage", &Module::writeSVGPage,
+            "writeSVGPage(page, filename, [decimals]): Exports the view part geometry of a DrawPage to a SVG file without a gui.\n"
+            "Coordinates are rounded to decimals places (default 3, -1 for no rounding)."
+        );
+        add_varargs_method("writeSVGPages", &Module::writeSVGPages,
+            "writeSVGPages([pages], [filenames], [decimals]): Exports several DrawPages to SVG files in parallel.\n"
+            "See writeSVGPage."
+        );
         add_varargs_method("findCentroid", &Module::findCentroid,
             "vector = findCentroid(shape, direction): finds geometric centroid of shape looking in direction."
         );
@@ -475,6 +488,92 @@ private:
     }
 
 
+    //! the edge shapes of a DrawViewPart that are written to svg. They are collected on the
+    //! calling thread, the writing does not touch the document objects.
+    struct SvgViewEdges
+    {
+        std::vector<TopoDS_Shape> visible;
+        std::vector<TopoDS_Shape> hidden;
+        double x{0.0};
+        double y{0.0};
+    };
+
+    SvgViewEdges getSvgViewEdges(TechDraw::DrawViewPart* dvp, bool withCosmetic)
+    {
+        SvgViewEdges result;
+        TechDraw::GeometryObjectPtr gObj = dvp->getGeometryObject();
+        if (!gObj) {
+            return result;
+        }
+        result.visible.push_back(gObj->getVisHard());
+        result.visible.push_back(gObj->getVisOutline());
+        if (dvp->SmoothVisible.getValue()) {
+            result.visible.push_back(gObj->getVisSmooth());
+        }
+        if (dvp->SeamVisible.getValue()) {
+            result.visible.push_back(gObj->getVisSeam());
+        }
+        if (dvp->HardHidden.getValue()) {
+            result.hidden.push_back(gObj->getHidHard());
+            result.hidden.push_back(gObj->getHidOutline());
+        }
+        if (dvp->SmoothHidden.getValue()) {
+            result.hidden.push_back(gObj->getHidSmooth());
+        }
+        if (dvp->SeamHidden.getValue()) {
+            result.hidden.push_back(gObj->getHidSeam());
+        }
+        if (withCosmetic) {
+            std::vector<TopoDS_Edge> cosmeticEdges;
+            for (auto& g : dvp->getEdgeGeometry()) {
+                if (g->getHlrVisible() && g->getCosmetic()) {
+                    cosmeticEdges.push_back(g->getOCCEdge());
+                }
+            }
+            if (!cosmeticEdges.empty()) {
+                result.visible.push_back(DrawUtil::vectorToCompound(cosmeticEdges));
+            }
+        }
+
+        double offX = 0.0;
+        double offY = 0.0;
+        if (DrawView::isProjGroupItem(dvp)) {
+            TechDraw::DrawProjGroupItem* dpgi = static_cast<TechDraw::DrawProjGroupItem*>(dvp);
+            TechDraw::DrawProjGroup*      dpg = dpgi->getPGroup();
+            if (dpg) {
+                offX = dpg->X.getValue();
+                offY = dpg->Y.getValue();
+            }
+        }
+        result.x = dvp->X.getValue() + offX;
+        result.y = dvp->Y.getValue() + offY;
+        return result;
+    }
+
+    void write1ViewSvg(std::ostream& out, SVGOutput& svgOut, const SvgViewEdges& edges,
+                       double thick, double thin)
+    {
+        const char* grpHead1 = "<g fill=\"none\" stroke=\"#000000\" stroke-opacity=\"1\" stroke-width=\"";
+        const char* grpHead2 = "\" stroke-linecap=\"butt\" stroke-linejoin=\"miter\" stroke-miterlimit=\"4\">\n";
+        const char* grpTail  = "</g>\n";
+
+        //visible group
+        out << grpHead1 << thick << grpHead2;
+        for (auto& shape : edges.visible) {
+            svgOut.exportEdges(shape, out);
+        }
+        out << grpTail;
+
+        if (!edges.hidden.empty()) {
+            //hidden group
+            out << grpHead1 << thin << grpHead2;
+            for (auto& shape : edges.hidden) {
+                svgOut.exportEdges(shape, out);
+            }
+            out << grpTail;
+        }
+    }
+
     Py::Object viewPartAsSvg(const Py::Tuple& args)
     {
         PyObject *viewObj(nullptr);
@@ -482,69 +581,22 @@ private:
             throw Py::TypeError("expected (DrawViewPart)");
         }
         Py::String svgReturn;
-        std::string grpHead1 = "<g fill=\"none\" stroke=\"#000000\" stroke-opacity=\"1\" stroke-width=\"";
-        std::string grpHead2 = "\" stroke-linecap=\"butt\" stroke-linejoin=\"miter\" stroke-miterlimit=\"4\">\n";
-        std::string grpTail  = "</g>\n";
         try {
             App::DocumentObject* obj = nullptr;
             TechDraw::DrawViewPart* dvp = nullptr;
             TechDraw::SVGOutput svgOut;
-            std::string svgText;
             std::stringstream ss;
             if (PyObject_TypeCheck(viewObj, &(TechDraw::DrawViewPartPy::Type))) {
                 obj = static_cast<App::DocumentObjectPy*>(viewObj)->getDocumentObjectPtr();
                 dvp = static_cast<TechDraw::DrawViewPart*>(obj);
-                TechDraw::GeometryObjectPtr gObj = dvp->getGeometryObject();
-                if (!gObj) {
+                if (!dvp->getGeometryObject()) {
                     Base::Console().message("TechDraw: %s has no geometry object!\n", dvp->Label.getValue());
                     return Py::String();
                 }
 
-                //visible group begin "<g ... >"
-                ss << grpHead1;
-                double thick = DrawUtil::getDefaultLineWeight("Thick");
-                ss << thick;
-                ss << grpHead2;
-                TopoDS_Shape shape = gObj->getVisHard();
-                ss << svgOut.exportEdges(shape);
-                shape = gObj->getVisOutline();
-                ss << svgOut.exportEdges(shape);
-                if (dvp->SmoothVisible.getValue()) {
-                    shape = gObj->getVisSmooth();
-                    ss << svgOut.exportEdges(shape);
-                }
-                if (dvp->SeamVisible.getValue()) {
-                    shape = gObj->getVisSeam();
-                    ss << svgOut.exportEdges(shape);
-                }
-                //visible group end "</g>"
-                ss << grpTail;
-
-                if ( dvp->HardHidden.getValue()  ||
-                     dvp->SmoothHidden.getValue() ||
-                     dvp->SeamHidden.getValue() ) {
-                    //hidden group begin
-                    ss << grpHead1;
-                    thick = DrawUtil::getDefaultLineWeight("Thin");
-                    ss << thick;
-                    ss << grpHead2;
-                    if (dvp->HardHidden.getValue()) {
-                        shape = gObj->getHidHard();
-                        ss << svgOut.exportEdges(shape);
-                        shape = gObj->getHidOutline();
-                        ss << svgOut.exportEdges(shape);
-                    }
-                    if (dvp->SmoothHidden.getValue()) {
-                        shape = gObj->getHidSmooth();
-                        ss << svgOut.exportEdges(shape);
-                    }
-                    if (dvp->SeamHidden.getValue()) {
-                        shape = gObj->getHidSeam();
-                        ss << svgOut.exportEdges(shape);
-                    }
-                    ss << grpTail;
-                    //hidden group end
-                }
+                write1ViewSvg(ss, svgOut, getSvgViewEdges(dvp, false),
+                              DrawUtil::getDefaultLineWeight("Thick"),
+                              DrawUtil::getDefaultLineWeight("Thin"));
                 // ss now contains all edges as Svg
                 svgReturn = Py::String(ss.str());
            }
@@ -557,6 +609,157 @@ private:
         return svgReturn;
     }
 
+    //! everything needed to write one page, see getSvgPage
+    struct SvgPage
+    {
+        std::string filePath;
+        double width{0.0};
+        double height{0.0};
+        std::vector<SvgViewEdges> views;
+    };
+
+    SvgPage getSvgPage(TechDraw::DrawPage* dPage, const std::string& filePath)
+    {
+        SvgPage page;
+        page.filePath = filePath;
+        page.width = dPage->getPageWidth();
+        page.height = dPage->getPageHeight();
+        for (auto& view : dPage->getAllViews()) {
+            if (view->isDerivedFrom<TechDraw::DrawViewPart>()) {
+                TechDraw::DrawViewPart* dvp = static_cast<TechDraw::DrawViewPart*>(view);
+                if (dvp->hasGeometry()) {
+                    page.views.push_back(getSvgViewEdges(dvp, true));
+                }
+            }
+        }
+        return page;
+    }
+
+    void write1PageSvg(const SvgPage& page, int decimals, double thick, double thin)
+    {
+        Base::FileInfo fi(page.filePath);
+        Base::ofstream out(fi, std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!out) {
+            throw Base::FileException("Cannot open file", fi);
+        }
+
+        SVGOutput svgOut;
+        svgOut.setPrecision(decimals);
+        out << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n"
+            << "<svg xmlns=\"http://www.w3.org/2000/svg\" version=\"1.1\" width=\""
+            << page.width << "mm\" height=\"" << page.height << "mm\" viewBox=\"0 0 "
+            << page.width << " " << page.height << "\">\n";
+        for (auto& view : page.views) {
+            // the view geometry has y pointing down, the view position is measured
+            // from the lower left page corner
+            out << "<g transform=\"translate(" << view.x << ", " << page.height - view.y << ")\">\n";
+            write1ViewSvg(out, svgOut, view, thick, thin);
+            out << "</g>\n";
+        }
+        out << "</svg>\n";
+        out.close();
+        if (out.fail()) {
+            throw Base::FileException("Failed to write file", fi);
+        }
+    }
+
+    //! write the pages on the global thread pool. The document is only read on the calling
+    //! thread, the GIL is released while the files are written.
+    void writeSvgPages(const std::vector<SvgPage>& pages, int decimals)
+    {
+        double thick = DrawUtil::getDefaultLineWeight("Thick");
+        double thin = DrawUtil::getDefaultLineWeight("Thin");
+
+        struct PageJob
+        {
+            const SvgPage* page;
+            std::exception_ptr error;
+        };
+        std::vector<PageJob> jobs;
+        jobs.reserve(pages.size());
+        for (auto& page : pages) {
+            jobs.push_back({&page, nullptr});
+        }
+
+        {
+            Base::PyGILStateRelease release;
+            QtConcurrent::blockingMap(jobs, [&](PageJob& job) {
+                try {
+                    write1PageSvg(*job.page, decimals, thick, thin);
+                }
+                catch (...) {
+                    job.error = std::current_exception();
+                }
+            });
+        }
+
+        for (auto& job : jobs) {
+            if (job.error) {
+                std::rethrow_exception(job.error);
+            }
+        }
+    }
+
+    Py::Object writeSVGPage(const Py::Tuple& args)
+    {
+        PyObject *pageObj(nullptr);
+        char* name(nullptr);
+        int decimals = 3;
+        if (!PyArg_ParseTuple(args.ptr(), "O!et|i", &(TechDraw::DrawPagePy::Type), &pageObj,
+                              "utf-8", &name, &decimals)) {
+            throw Py::TypeError("expected (page, path, [decimals])");
+        }
+
+        std::string filePath = std::string(name);
+        PyMem_Free(name);
+
+        try {
+            auto dPage = static_cast<TechDraw::DrawPage*>(
+                static_cast<App::DocumentObjectPy*>(pageObj)->getDocumentObjectPtr());
+            writeSvgPages({getSvgPage(dPage, filePath)}, decimals);
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+
+        return Py::None();
+    }
+
+    Py::Object writeSVGPages(const Py::Tuple& args)
+    {
+        PyObject *pagesObj(nullptr);
+        PyObject *namesObj(nullptr);
+        int decimals = 3;
+        if (!PyArg_ParseTuple(args.ptr(), "OO|i", &pagesObj, &namesObj, &decimals)) {
+            throw Py::TypeError("expected ([pages], [paths], [decimals])");
+        }
+
+        Py::Sequence pageList(pagesObj);
+        Py::Sequence nameList(namesObj);
+        if (pageList.size() != nameList.size()) {
+            throw Py::ValueError("number of pages and file names differ");
+        }
+
+        try {
+            std::vector<SvgPage> pages;
+            for (Py_ssize_t i = 0; i < pageList.size(); ++i) {
+                Py::Object pageObj = pageList[i];
+                if (!PyObject_TypeCheck(pageObj.ptr(), &(TechDraw::DrawPagePy::Type))) {
+                    throw Py::TypeError("expected a list of DrawPages");
+                }
+                auto dPage = static_cast<TechDraw::DrawPage*>(
+                    static_cast<App::DocumentObjectPy*>(pageObj.ptr())->getDocumentObjectPtr());
+                pages.push_back(getSvgPage(dPage, Py::String(nameList[i]).as_std_string("utf-8")));
+            }
+            writeSvgPages(pages, decimals);
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+
+        return Py::None();
+    }
+
     void write1ViewDxf( ImpExpDxfWrite& writer, TechDraw::DrawViewPart* dvp, bool alignPage)
     {
         if(!dvp->hasGeometry()) {
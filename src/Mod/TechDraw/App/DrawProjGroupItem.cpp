@@ -170,7 +170,7 @@ void DrawProjGroupItem::autoPosition()
 void DrawProjGroupItem::onDocumentRestored()
 {
 //    Base::Console().message("DPGI::onDocumentRestored() - %s\n", getNameInDocument());
-    DrawView::onDocumentRestored();
+    DrawViewPart::onDocumentRestored();
     App::DocumentObjectExecReturn* rc = DrawProjGroupItem::execute();
     if (rc) {
         delete rc;
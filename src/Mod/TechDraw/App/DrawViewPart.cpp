@@ -50,6 +50,7 @@
 #include <ShapeAnalysis.hxx>
 #include <TopExp.hxx>
 #include <TopExp_Explorer.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
 #include <TopoDS.hxx>
 #include <TopoDS_Edge.hxx>
 #include <TopoDS_Face.hxx>
@@ -60,6 +61,7 @@
 #include <gp_Dir.hxx>
 #include <gp_Pln.hxx>
 #include <gp_Pnt.hxx>
+#include <iomanip>
 #include <sstream>
 
 
@@ -148,6 +150,13 @@ DrawViewPart::DrawViewPart()
     ADD_PROPERTY_TYPE(ScrubCount, (Preferences::scrubCount()), sgroup, App::Prop_None,
                       "The number of times FreeCAD should try to clean the HLR result.");
 
+    ADD_PROPERTY_TYPE(HlrCacheKey, (""), sgroup,
+                      (App::PropertyType)(App::Prop_Output | App::Prop_NoRecompute | App::Prop_Hidden),
+                      "Key of the saved HLR result");
+    ADD_PROPERTY_TYPE(HlrCacheShape, (TopoDS_Shape()), sgroup,
+                      (App::PropertyType)(App::Prop_Output | App::Prop_NoRecompute | App::Prop_Hidden),
+                      "Saved HLR result");
+
     //initialize bbox to non-garbage
     bbox = Base::BoundBox3d(Base::Vector3d(0.0, 0.0, 0.0), 0.0);
 }
@@ -314,6 +323,8 @@ GeometryObjectPtr DrawViewPart::makeGeometryForShape(TopoDS_Shape& shape)
     bool copyMesh = false;
     BRepBuilderAPI_Copy copier(shape, copyGeometry, copyMesh);
     TopoDS_Shape localShape = copier.Shape();
+    // the copy has new TShapes, so the hlr cache works with the original
+    m_hlrSource = shape;
 
     gp_Pnt gCentroid = ShapeUtils::findCentroid(localShape, getProjectionCS());
     m_saveCentroid = Base::convertTo<Base::Vector3d>(gCentroid);
@@ -349,9 +360,22 @@ TechDraw::GeometryObjectPtr DrawViewPart::buildGeometryObject(TopoDS_Shape& shap
     go->setIsoCount(IsoCount.getValue());
     go->isPerspective(Perspective.getValue());
     go->setFocus(Focus.getValue());
-    go->usePolygonHLR(CoarseView.getValue());
+    go->usePolygonHLR(CoarseView.getValue() || isTooLargeForHlr(shape));
     go->setScrubCount(ScrubCount.getValue());
 
+    // only shapes prepared by makeGeometryForShape have a known source for the hlr cache
+    if (!m_hlrSource.IsNull()) {
+        std::ostringstream viewKey;
+        viewKey << std::setprecision(12) << getScale() << ',' << Rotation.getValue();
+        go->setHlrSource(m_hlrSource, viewKey.str());
+        m_hlrSource.Nullify();
+        if (!m_restoredHlrKey.empty()) {
+            go->setSavedHlr(m_restoredHlrKey, m_restoredHlr);
+            m_restoredHlrKey.clear();
+            m_restoredHlr = TechDraw::HlrShapes();
+        }
+    }
+
     if (CoarseView.getValue()) {
         //the polygon approximation HLR process runs quickly, so doesn't need to be in a
         //separate thread
@@ -362,7 +386,12 @@ TechDraw::GeometryObjectPtr DrawViewPart::buildGeometryObject(TopoDS_Shape& shap
     if (!DU::isGuiUp()) {
         // if the Gui is not running (actual the event loop), we cannot use the separate thread,
         // since we will never be notified of thread completion.
-        go->projectShape(shape, viewAxis);
+        if (go->usePolygonHLR()) {
+            go->projectShapeWithPolygonAlgo(shape, viewAxis);
+        }
+        else {
+            go->projectShape(shape, viewAxis);
+        }
         return go;
     }
 
@@ -376,7 +405,16 @@ TechDraw::GeometryObjectPtr DrawViewPart::buildGeometryObject(TopoDS_Shape& shap
     // We create a lambda closure to hold a copy of go, shape and viewAxis.
     // This is important because those variables might be local to the calling
     // function and might get destructed before the parallel processing finishes.
-    auto lambda = [go, shape, viewAxis]{go->projectShape(shape, viewAxis);};
+    // Very large shapes fall back to the polygon algorithm, but unlike a coarse view it still
+    // takes long enough to warrant the separate thread.
+    auto lambda = [go, shape, viewAxis] {
+        if (go->usePolygonHLR()) {
+            go->projectShapeWithPolygonAlgo(shape, viewAxis);
+        }
+        else {
+            go->projectShape(shape, viewAxis);
+        }
+    };
     m_hlrFuture = QtConcurrent::run(std::move(lambda));
     m_hlrWatcher.setFuture(m_hlrFuture);
     waitingForHlr(true);
@@ -384,6 +422,46 @@ TechDraw::GeometryObjectPtr DrawViewPart::buildGeometryObject(TopoDS_Shape& shap
     return go;
 }
 
+//! true if the shape has so many faces that the exact HLR would take too long
+bool DrawViewPart::isTooLargeForHlr(const TopoDS_Shape& shape) const
+{
+    int limit = Preferences::hlrPolygonFaceCount();
+    if (limit <= 0 || shape.IsNull()) {
+        return false;
+    }
+    TopTools_IndexedMapOfShape faceMap;
+    TopExp::MapShapes(shape, TopAbs_FACE, faceMap);
+    if (faceMap.Extent() <= limit) {
+        return false;
+    }
+    Base::Console().warning("%s has %d faces, using the polygon HLR algorithm\n",
+                            getNameInDocument(), faceMap.Extent());
+    return true;
+}
+
+//! keep the hlr result of the current geometry in the document
+void DrawViewPart::saveHlrCache()
+{
+    const std::string& key = geometryObject->getHlrKey();
+    if (key == m_savedHlrKey) {
+        return;
+    }
+    m_savedHlrKey = key;
+    if (geometryObject->usedSavedHlr()) {
+        // the properties already hold this result
+        return;
+    }
+    if (key.empty()) {
+        HlrCacheShape.setValue(TopoDS_Shape());
+        HlrCacheKey.setValue("");
+    }
+    else {
+        HlrCacheShape.setValue(
+            TechDraw::GeometryObject::packHlrShapes(geometryObject->getHlrShapes()));
+        HlrCacheKey.setValue(geometryObject->makeSavedHlrKey());
+    }
+}
+
 //! continue processing after hlr thread completes
 void DrawViewPart::onHlrFinished()
 {
@@ -401,6 +479,8 @@ void DrawViewPart::onHlrFinished()
                               getNameInDocument(), Label.getValue());
     }
 
+    saveHlrCache();
+
     //the last hlr related task is to make a bbox of the results
     bbox = geometryObject->calcBoundingBox();
 
@@ -419,7 +499,7 @@ void DrawViewPart::onHlrFinished()
         return;
     }
 
-    if (handleFaces() && !CoarseView.getValue()) {
+    if (handleFaces() && !geometryObject->usePolygonHLR()) {
         try {
             //note that &m_faceWatcher in the third parameter is not strictly required, but using the
             //4 parameter signature instead of the 3 parameter signature prevents clazy warning:
@@ -458,7 +538,7 @@ void DrawViewPart::postHlrTasks()
         balloon->recomputeFeature();
     }
     // Dimensions need to be recomputed now if face finding is not going to take place.
-    if (!handleFaces() || CoarseView.getValue()) {
+    if (!handleFaces() || geometryObject->usePolygonHLR()) {
         std::vector<TechDraw::DrawViewDimension*> dimsAll = getDimensions();
         for (auto& dim : dimsAll) {
             dim->recomputeFeature();
@@ -1510,6 +1590,17 @@ void DrawViewPart::resetReferenceVerts()
     addReferencesToGeom();
 }
 
+void DrawViewPart::onDocumentRestored()
+{
+    // unpack the saved hlr result once. The first projection uses it if the source still
+    // matches.
+    if (Preferences::cacheHlr() && !HlrCacheKey.isEmpty()
+        && TechDraw::GeometryObject::unpackHlrShapes(HlrCacheShape.getValue(), m_restoredHlr)) {
+        m_restoredHlrKey = HlrCacheKey.getValue();
+    }
+    DrawView::onDocumentRestored();
+}
+
 void DrawViewPart::handleChangedPropertyType(Base::XMLReader &reader, const char * TypeName, App::Property * prop)
 {
     if (prop == &Direction) {
@@ -35,10 +35,12 @@
 #include <App/FeaturePython.h>
 #include <App/PropertyLinks.h>
 #include <Base/BoundBox.h>
+#include <Mod/Part/App/PropertyTopoShape.h>
 #include <Mod/TechDraw/TechDrawGlobal.h>
 
 #include "CosmeticExtension.h"
 #include "DrawView.h"
+#include "GeometryObject.h"
 
 
 class gp_Pnt;
@@ -53,8 +55,6 @@ class Part;
 
 namespace TechDraw
 {
-class GeometryObject;
-using GeometryObjectPtr = std::shared_ptr<GeometryObject>;
 class Vertex;
 class BaseGeom;
 class Face;
@@ -135,10 +135,15 @@ public:
 
     App::PropertyInteger ScrubCount;
 
+    // saved hlr result, so reopening the document does not need to run hlr again
+    App::PropertyString HlrCacheKey;
+    Part::PropertyPartShape HlrCacheShape;
+
     short mustExecute() const override;
     App::DocumentObjectExecReturn* execute() override;
     const char* getViewProviderName() const override { return "TechDrawGui::ViewProviderViewPart"; }
     PyObject* getPyObject() override;
+    void onDocumentRestored() override;
     void handleChangedPropertyType(
         Base::XMLReader &reader, const char * TypeName, App::Property * prop) override;
 
@@ -263,6 +268,8 @@ protected:
     virtual TechDraw::GeometryObjectPtr buildGeometryObject(TopoDS_Shape& shape,
                                                             const gp_Ax2& viewAxis);
     virtual TechDraw::GeometryObjectPtr makeGeometryForShape(TopoDS_Shape& shape);//const??
+    bool isTooLargeForHlr(const TopoDS_Shape& shape) const;
+    void saveHlrCache();
     void partExec(TopoDS_Shape& shape);
     virtual void addPoints(void);
 
@@ -276,6 +283,10 @@ protected:
 
     TopoDS_Shape m_saveShape;     //TODO: make this a Property.  Part::TopoShapeProperty??
     Base::Vector3d m_saveCentroid;//centroid before centering shape in origin
+    TopoDS_Shape m_hlrSource;     //shape passed to makeGeometryForShape, before the copy
+    TechDraw::HlrShapes m_restoredHlr;//hlr result loaded with the document
+    std::string m_restoredHlrKey;
+    std::string m_savedHlrKey;    //hlr cache key of the result in HlrCacheShape
 
     std::vector<TechDraw::VertexPtr> m_referenceVerts;
 
@@ -167,3 +167,7 @@ class DrawViewPart(DrawView):
     def requestPaint(self) -> Any:
         """requestPaint(). Redraw the graphic for this View."""
         ...
+
+    def usedSavedHlr(self) -> Any:
+        """usedSavedHlr() - returns True if the current geometry comes from the hlr result saved with the document."""
+        ...
@@ -184,6 +184,16 @@ PyObject* DrawViewPartPy::getGeometricCenter(PyObject *args)
     return new Base::VectorPy(new Base::Vector3d(pointOut));
 }
 
+PyObject* DrawViewPartPy::usedSavedHlr(PyObject *args)
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return nullptr;
+    }
+
+    TechDraw::GeometryObjectPtr go = getDrawViewPartPtr()->getGeometryObject();
+    return Py::new_reference_to(Py::Boolean(go && go->usedSavedHlr()));
+}
+
 
 // remove all cosmetics
 PyObject* DrawViewPartPy::clearCosmeticVertices(PyObject *args)
@@ -26,9 +26,13 @@
 //**************************************************************************
 
 
+# include <algorithm>
 # include <cmath>
 # include <limits>
+# include <set>
 # include <sstream>
+# include <tuple>
+# include <unordered_map>
 # include <BRep_Tool.hxx>
 # include <BRepBuilderAPI_MakeWire.hxx>
 # include <ShapeAnalysis.hxx>
@@ -48,6 +52,76 @@
 using namespace TechDraw;
 using namespace boost;
 
+namespace {
+
+//! finds points within a tolerance of each other by hashing them into cells of the
+//! tolerance size, so only the neighbouring cells need to be searched
+class VertexGrid
+{
+public:
+    explicit VertexGrid(double tolerance) : m_tolerance(tolerance) {}
+
+    //! index of the first added point within tolerance of pt, or size_t max if none
+    std::size_t find(const Base::Vector3d& pt) const
+    {
+        std::size_t result = std::numeric_limits<std::size_t>::max();
+        Cell cell = cellOf(pt);
+        for (long long dx = -1; dx <= 1; dx++) {
+            for (long long dy = -1; dy <= 1; dy++) {
+                for (long long dz = -1; dz <= 1; dz++) {
+                    auto it = m_cells.find(Cell(std::get<0>(cell) + dx,
+                                                std::get<1>(cell) + dy,
+                                                std::get<2>(cell) + dz));
+                    if (it == m_cells.end()) {
+                        continue;
+                    }
+                    for (auto index : it->second) {
+                        if (index < result && m_points[index].IsEqual(pt, m_tolerance)) {
+                            result = index;
+                        }
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+    std::size_t add(const Base::Vector3d& pt)
+    {
+        std::size_t index = m_points.size();
+        m_points.push_back(pt);
+        m_cells[cellOf(pt)].push_back(index);
+        return index;
+    }
+
+private:
+    using Cell = std::tuple<long long, long long, long long>;
+
+    struct CellHash
+    {
+        std::size_t operator()(const Cell& cell) const
+        {
+            std::size_t seed = std::hash<long long>()(std::get<0>(cell));
+            seed ^= std::hash<long long>()(std::get<1>(cell)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            seed ^= std::hash<long long>()(std::get<2>(cell)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+            return seed;
+        }
+    };
+
+    Cell cellOf(const Base::Vector3d& pt) const
+    {
+        return Cell(static_cast<long long>(std::floor(pt.x / m_tolerance)),
+                    static_cast<long long>(std::floor(pt.y / m_tolerance)),
+                    static_cast<long long>(std::floor(pt.z / m_tolerance)));
+    }
+
+    double m_tolerance;
+    std::vector<Base::Vector3d> m_points;
+    std::unordered_map<Cell, std::vector<std::size_t>, CellHash> m_cells;
+};
+
+}  // namespace
+
 //*******************************************************
 //* edgeVisior methods
 //*******************************************************
@@ -269,26 +343,20 @@ std::vector<TopoDS_Vertex> EdgeWalker:: makeUniqueVList(std::vector<TopoDS_Edge>
 {
 //    Base::Console().message("TRACE - EW::makeUniqueVList() - edgesIn: %d\n", edges.size());
     std::vector<TopoDS_Vertex> uniqueVert;
+    VertexGrid grid(EWTOLERANCE);
     for(auto& e:edges) {
         Base::Vector3d v1 = DrawUtil::vertex2Vector(TopExp::FirstVertex(e));
         Base::Vector3d v2 = DrawUtil::vertex2Vector(TopExp::LastVertex(e));
-        bool addv1 = true;
-        bool addv2 = true;
         //check if we've already added this vertex
-        for (const auto& v: uniqueVert) {
-            Base::Vector3d v3d = DrawUtil::vertex2Vector(v);
-            if (v3d.IsEqual(v1, EWTOLERANCE)) {
-                addv1 = false;
-            }
-            if (v3d.IsEqual(v2, EWTOLERANCE)) {
-                addv2 = false;
-            }
-        }
+        bool addv1 = grid.find(v1) == std::numeric_limits<std::size_t>::max();
+        bool addv2 = grid.find(v2) == std::numeric_limits<std::size_t>::max();
         if (addv1) {
             uniqueVert.push_back(TopExp::FirstVertex(e));
+            grid.add(v1);
         }
         if (addv2) {
             uniqueVert.push_back(TopExp::LastVertex(e));
+            grid.add(v2);
         }
     }
 //    Base::Console().message("EW::makeUniqueVList - verts out: %d\n", uniqueVert.size());
@@ -301,15 +369,18 @@ std::vector<WalkerEdge> EdgeWalker::makeWalkerEdges(std::vector<TopoDS_Edge> edg
 {
 //    Base::Console().message("TRACE - EW::makeWalkerEdges() - edges: %d  verts: %d\n", edges.size(), verts.size());
     m_saveInEdges = edges;
+    VertexGrid grid(EWTOLERANCE);
+    for (auto& v : verts) {
+        grid.add(DrawUtil::vertex2Vector(v));
+    }
+
     std::vector<WalkerEdge> walkerEdges;
     for (const auto& e:edges) {
-        TopoDS_Vertex edgeVertex1 = TopExp::FirstVertex(e);
-        TopoDS_Vertex edgeVertex2 = TopExp::LastVertex(e);
-        std::size_t vertex1Index = findUniqueVert(edgeVertex1, verts);
+        std::size_t vertex1Index = grid.find(DrawUtil::vertex2Vector(TopExp::FirstVertex(e)));
         if (vertex1Index == std::numeric_limits<std::size_t>::max()) {
             continue;
         }
-        std::size_t vertex2Index = findUniqueVert(edgeVertex2, verts);
+        std::size_t vertex2Index = grid.find(DrawUtil::vertex2Vector(TopExp::LastVertex(e)));
         if (vertex2Index == std::numeric_limits<std::size_t>::max()) {
             continue;
         }
@@ -325,21 +396,6 @@ std::vector<WalkerEdge> EdgeWalker::makeWalkerEdges(std::vector<TopoDS_Edge> edg
     return walkerEdges;
 }
 
-size_t EdgeWalker::findUniqueVert(TopoDS_Vertex vx, std::vector<TopoDS_Vertex> &uniqueVert)
-{
-//    Base::Console().message("TRACE - EW::findUniqueVert()\n");
-    std::size_t idx = 0;
-    Base::Vector3d vx3d = DrawUtil::vertex2Vector(vx);
-    for(auto& v : uniqueVert) {
-        Base::Vector3d v3d = DrawUtil::vertex2Vector(v);
-        if (vx3d.IsEqual(v3d, EWTOLERANCE)) {
-            return idx;
-        }
-        idx++;
-    }
-    return std::numeric_limits<std::size_t>::max();
-}
-
 std::vector<TopoDS_Wire> EdgeWalker::sortStrip(std::vector<TopoDS_Wire> fw, bool includeBiggest)
 {
     std::vector<TopoDS_Wire> closedWires;                  //all the wires should be closed, but anomalies happen
@@ -365,22 +421,27 @@ std::vector<TopoDS_Wire> EdgeWalker::sortStrip(std::vector<TopoDS_Wire> fw, bool
 std::vector<TopoDS_Wire> EdgeWalker::sortWiresBySize(std::vector<TopoDS_Wire>& w, bool ascend)
 {
     //Base::Console().message("TRACE - EW::sortWiresBySize()\n");
-    std::vector<TopoDS_Wire> wires = w;
-    std::sort(wires.begin(), wires.end(), EdgeWalker::wireCompare);
+    //the contour area is expensive, so compute it once per wire instead of per comparison
+    std::vector<std::pair<double, std::size_t>> areas;
+    areas.reserve(w.size());
+    for (std::size_t i = 0; i < w.size(); i++) {
+        areas.emplace_back(ShapeAnalysis::ContourArea(w[i]), i);
+    }
+    std::sort(areas.begin(), areas.end(), [](const auto& a1, const auto& a2) {
+        return a1.first > a2.first;
+    });
+
+    std::vector<TopoDS_Wire> wires;
+    wires.reserve(w.size());
+    for (auto& area : areas) {
+        wires.push_back(w[area.second]);
+    }
     if (ascend) {
         std::reverse(wires.begin(), wires.end());
     }
     return wires;
 }
 
-//! return true if w1 enclosed area is bigger than w2 enclosed area
-/*static*/bool EdgeWalker::wireCompare(const TopoDS_Wire& w1, const TopoDS_Wire& w2)
-{
-    double area1 = ShapeAnalysis::ContourArea(w1);
-    double area2 = ShapeAnalysis::ContourArea(w2);
-    return area1 > area2;
-}
-
 std::vector<embedItem> EdgeWalker::makeEmbedding(const std::vector<TopoDS_Edge> edges,
                                                  const std::vector<TopoDS_Vertex> uniqueVList)
 {
@@ -388,34 +449,25 @@ std::vector<embedItem> EdgeWalker::makeEmbedding(const std::vector<TopoDS_Edge>
 //                            edges.size(), uniqueVList.size());
     std::vector<embedItem> result;
 
-    std::size_t iVert = 0;
-    //make an embedItem for each vertex in uniqueVList
-    //for each vertex v
-    //  find all the edges that have v as first or last vertex
-    for (auto& v: uniqueVList) {
-        TopoDS_Vertex cv = v;               //v is const but we need non-const for vertexEqual
-        std::size_t iEdge = 0;
-        std::vector<incidenceItem> iiList;
-        for (auto& e: edges) {
-            double angle = 0;
-            TopoDS_Vertex edgeVertex1 = TopExp::FirstVertex(e);
-            TopoDS_Vertex edgeVertex2 = TopExp::LastVertex(e);
-            if (DrawUtil::vertexEqual(cv, edgeVertex1)) {
-                angle = DrawUtil::incidenceAngleAtVertex(e,v,EWTOLERANCE);
-                incidenceItem ii(iEdge, angle, m_saveWalkerEdges[iEdge].ed);
-                iiList.push_back(ii);
-            } else if (DrawUtil::vertexEqual(cv, edgeVertex2)) {
-                angle = DrawUtil::incidenceAngleAtVertex(e,v,EWTOLERANCE);
-                incidenceItem ii(iEdge, angle, m_saveWalkerEdges[iEdge].ed);
-                iiList.push_back(ii);
-            }
-            iEdge++;
-       }
-       //sort incidenceList by angle
-       iiList = embedItem::sortIncidenceList(iiList,  false);
-       embedItem embed(iVert, iiList);
-       result.push_back(embed);
-       iVert++;
+    //collect the edges ending at each vertex from the walker edges, which already hold the
+    //unique vertex indices of both ends
+    std::vector<std::vector<incidenceItem>> incidence(uniqueVList.size());
+    for (std::size_t iEdge = 0; iEdge < edges.size() && iEdge < m_saveWalkerEdges.size(); iEdge++) {
+        const WalkerEdge& we = m_saveWalkerEdges[iEdge];
+        const TopoDS_Edge& e = edges[iEdge];
+        double angle = DrawUtil::incidenceAngleAtVertex(e, uniqueVList[we.v1], EWTOLERANCE);
+        incidence[we.v1].emplace_back(iEdge, angle, we.ed);
+        if (we.v2 != we.v1) {
+            angle = DrawUtil::incidenceAngleAtVertex(e, uniqueVList[we.v2], EWTOLERANCE);
+            incidence[we.v2].emplace_back(iEdge, angle, we.ed);
+        }
+    }
+
+    result.reserve(uniqueVList.size());
+    for (std::size_t iVert = 0; iVert < uniqueVList.size(); iVert++) {
+        //sort incidenceList by angle
+        std::vector<incidenceItem> iiList = embedItem::sortIncidenceList(incidence[iVert], false);
+        result.emplace_back(iVert, iiList);
     }
     return result;
 }
@@ -518,18 +570,17 @@ ewWireList ewWireList::removeDuplicateWires()
     if (wires.empty()) {
         return result;
     }
-    result.push_back(*(wires.begin()));                //save the first ewWire
-    std::vector<ewWire>::iterator iWire = (wires.begin()) + 1;    //starting with second
-    for (; iWire != wires.end(); iWire++) {
-        bool addToResult = true;
-        for (auto& w:result.wires) {
-            if ((*iWire).isEqual(w))  {             //already in result?
-                addToResult = false;
-                break;
-            }
+    //wires are equal if they use the same set of edges, so key them by their sorted edge indices
+    std::set<std::vector<std::size_t>> seen;
+    for (auto& wire : wires) {
+        std::vector<std::size_t> key;
+        key.reserve(wire.wedges.size());
+        for (auto& we : wire.wedges) {
+            key.push_back(we.idx);
         }
-        if (addToResult) {
-            result.push_back((*iWire));
+        std::sort(key.begin(), key.end());
+        if (seen.insert(std::move(key)).second) {
+            result.push_back(wire);
         }
     }
     return result;
@@ -44,9 +44,13 @@
 #include <HLRBRep_HLRToShape.hxx>
 #include <HLRBRep_PolyAlgo.hxx>
 #include <HLRBRep_PolyHLRToShape.hxx>
+#include <Standard_Version.hxx>
 #include <TopExp.hxx>
 #include <TopExp_Explorer.hxx>
+#include <TopTools_IndexedMapOfShape.hxx>
 #include <TopoDS.hxx>
+#include <TopoDS_Compound.hxx>
+#include <TopoDS_Iterator.hxx>
 #include <TopoDS_Edge.hxx>
 #include <TopoDS_Face.hxx>
 #include <TopoDS_Shape.hxx>
@@ -60,7 +64,19 @@
 #include <gp_Vec.hxx>
 
 #include <algorithm>
+#include <cfloat>
 #include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+
+#include <QtConcurrentMap>
 
 #include <Base/Console.h>
 #include <Mod/Part/App/PartFeature.h>
@@ -71,6 +87,7 @@
 #include "DrawViewPart.h"
 #include "GeometryObject.h"
 #include "DrawProjectSplit.h"
+#include "Preferences.h"
 #include "ShapeUtils.h"
 
 using namespace TechDraw;
@@ -141,6 +158,477 @@ void GeometryObject::projectShape(const TopoDS_Shape& inShape, const gp_Ax2& vie
 {
     clear();
 
+    m_hlrKey.clear();
+    m_usedSavedHlr = false;
+    if (Preferences::cacheHlr() && !m_hlrSource.IsNull()) {
+        m_hlrOptionsKey = makeHlrOptionsKey(viewAxis);
+        m_hlrKey = makeHlrKey();
+        HlrShapes cached;
+        if (findInHlrCache(m_hlrKey, m_hlrSource, cached)) {
+            setHlrShapes(cached);
+            makeTDGeometry();
+            return;
+        }
+        if (!m_savedHlrKey.empty() && m_savedHlrKey == makeSavedHlrKey()) {
+            m_usedSavedHlr = true;
+            setHlrShapes(m_savedHlr);
+            addToHlrCache(m_hlrKey, m_hlrSource, m_savedHlr);
+            makeTDGeometry();
+            return;
+        }
+    }
+
+    runHlr(inShape, viewAxis);
+    if (!m_hlrKey.empty()) {
+        addToHlrCache(m_hlrKey, m_hlrSource, getHlrShapes());
+    }
+
+    makeTDGeometry();
+}
+
+//! find the visible and hidden edges of a shape, splitting the work into independent hlr
+//! passes when possible
+void GeometryObject::runHlr(const TopoDS_Shape& inShape, const gp_Ax2& viewAxis)
+{
+    std::vector<TopoDS_Shape> groups = partitionForHlr(inShape, viewAxis);
+    if (groups.size() < 2) {
+        hideLines(inShape, viewAxis);
+        return;
+    }
+
+    // the groups do not overlap in the view, so they can not hide each other and each one
+    // gets its own hlr pass. The passes run on the global thread pool, which also runs the hlr
+    // of the other views, so the number of threads stays bounded when many views update.
+    struct HlrPass
+    {
+        TopoDS_Shape shape;
+        std::unique_ptr<GeometryObject> part;
+        std::exception_ptr error;
+    };
+    std::vector<HlrPass> passes(groups.size());
+    for (size_t i = 0; i < groups.size(); i++) {
+        passes[i].shape = groups[i];
+        passes[i].part = std::make_unique<GeometryObject>(m_parentName, nullptr);
+        passes[i].part->setIsoCount(m_isoCount);
+    }
+
+    QtConcurrent::blockingMap(passes, [&viewAxis](HlrPass& pass) {
+        try {
+            pass.part->hideLines(pass.shape, viewAxis);
+        }
+        catch (...) {
+            pass.error = std::current_exception();
+        }
+    });
+    for (auto& pass : passes) {
+        if (pass.error) {
+            std::rethrow_exception(pass.error);
+        }
+    }
+
+    // merge the visible and hidden edges of all groups
+    auto merge = [&passes](TopoDS_Shape GeometryObject::*member) {
+        BRep_Builder builder;
+        TopoDS_Compound result;
+        builder.MakeCompound(result);
+        bool empty = true;
+        for (auto& pass : passes) {
+            const TopoDS_Shape& edges = (*pass.part).*member;
+            if (!edges.IsNull()) {
+                builder.Add(result, edges);
+                empty = false;
+            }
+        }
+        return empty ? TopoDS_Shape() : TopoDS_Shape(result);
+    };
+    visHard = merge(&GeometryObject::visHard);
+    visOutline = merge(&GeometryObject::visOutline);
+    visSmooth = merge(&GeometryObject::visSmooth);
+    visSeam = merge(&GeometryObject::visSeam);
+    visIso = merge(&GeometryObject::visIso);
+    hidHard = merge(&GeometryObject::hidHard);
+    hidOutline = merge(&GeometryObject::hidOutline);
+    hidSmooth = merge(&GeometryObject::hidSmooth);
+    hidSeam = merge(&GeometryObject::hidSeam);
+    hidIso = merge(&GeometryObject::hidIso);
+}
+
+namespace
+{
+
+//! the shapes a hlr source is made of. The source compound is rebuilt for every projection,
+//! but its children are the shapes of the source objects.
+std::vector<TopoDS_Shape> getHlrSourceParts(const TopoDS_Shape& source)
+{
+    std::vector<TopoDS_Shape> parts;
+    if (source.ShapeType() != TopAbs_COMPOUND) {
+        parts.push_back(source);
+        return parts;
+    }
+    for (TopoDS_Iterator it(source); it.More(); it.Next()) {
+        parts.push_back(it.Value());
+    }
+    return parts;
+}
+
+void hashCombine(size_t& seed, size_t value)
+{
+    seed ^= value + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+//! true if the parts share their TShapes, orientations and placements, i.e. the hlr input
+//! did not change
+bool sameHlrSourceParts(const std::vector<TopoDS_Shape>& a, const std::vector<TopoDS_Shape>& b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].TShape() != b[i].TShape() || a[i].Orientation() != b[i].Orientation()) {
+            return false;
+        }
+        const gp_Trsf& ta = a[i].Location().Transformation();
+        const gp_Trsf& tb = b[i].Location().Transformation();
+        for (int row = 1; row <= 3; row++) {
+            for (int col = 1; col <= 4; col++) {
+                if (ta.Value(row, col) != tb.Value(row, col)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+struct HlrCacheEntry
+{
+    // keeping the source parts alive also keeps their TShape addresses from being reused
+    std::vector<TopoDS_Shape> sourceParts;
+    HlrShapes shapes;
+    unsigned long lastUse;
+};
+
+//! hlr results shared by all views, keyed by GeometryObject::makeHlrKey
+class HlrCache
+{
+public:
+    static HlrCache& instance()
+    {
+        static HlrCache cache;
+        return cache;
+    }
+
+    void add(const std::string& key, const TopoDS_Shape& source, const HlrShapes& shapes)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        entries[key] = HlrCacheEntry{getHlrSourceParts(source), shapes, ++useCount};
+        while (entries.size() > MaxEntries) {
+            auto oldest = std::min_element(entries.begin(), entries.end(),
+                                           [](const auto& a, const auto& b) {
+                                               return a.second.lastUse < b.second.lastUse;
+                                           });
+            entries.erase(oldest);
+        }
+    }
+
+    bool find(const std::string& key, const TopoDS_Shape& source, HlrShapes& shapes)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = entries.find(key);
+        if (it == entries.end()
+            || !sameHlrSourceParts(it->second.sourceParts, getHlrSourceParts(source))) {
+            return false;
+        }
+        it->second.lastUse = ++useCount;
+        shapes = it->second.shapes;
+        return true;
+    }
+
+private:
+    static constexpr size_t MaxEntries = 64;
+
+    std::mutex mutex;
+    std::map<std::string, HlrCacheEntry> entries;
+    unsigned long useCount = 0;
+};
+
+}  // namespace
+
+void GeometryObject::setHlrSource(const TopoDS_Shape& source, const std::string& viewKey)
+{
+    m_hlrSource = source;
+    m_hlrViewKey = viewKey;
+}
+
+void GeometryObject::setSavedHlr(const std::string& key, const HlrShapes& shapes)
+{
+    m_savedHlrKey = key;
+    m_savedHlr = shapes;
+}
+
+//! the part of the hlr cache key that describes the projection and the hlr options
+std::string GeometryObject::makeHlrOptionsKey(const gp_Ax2& viewAxis) const
+{
+    std::ostringstream key;
+    key << std::setprecision(12);
+    auto addPoint = [&key](const gp_XYZ& xyz) {
+        key << ':' << xyz.X() << ',' << xyz.Y() << ',' << xyz.Z();
+    };
+    addPoint(viewAxis.Location().XYZ());
+    addPoint(viewAxis.Direction().XYZ());
+    addPoint(viewAxis.XDirection().XYZ());
+    key << ':' << m_isoCount << ':' << m_isPersp;
+    if (m_isPersp) {
+        key << ':' << m_focus;
+    }
+    key << ':' << m_hlrViewKey;
+    return key.str();
+}
+
+//! build the cache key of a hlr run from the TShapes, orientations and placements of the
+//! source parts and the options key. This is cheap, but only valid in this session, and
+//! findInHlrCache checks the parts again since the hash can collide.
+std::string GeometryObject::makeHlrKey() const
+{
+    size_t seed = 0;
+    for (auto& part : getHlrSourceParts(m_hlrSource)) {
+        hashCombine(seed, std::hash<const void*>{}(part.TShape().get()));
+        hashCombine(seed, static_cast<size_t>(part.Orientation()));
+        const gp_Trsf& trsf = part.Location().Transformation();
+        for (int row = 1; row <= 3; row++) {
+            for (int col = 1; col <= 4; col++) {
+                hashCombine(seed, std::hash<double>{}(trsf.Value(row, col)));
+            }
+        }
+    }
+
+    std::ostringstream key;
+    key << std::hex << seed << std::dec << m_hlrOptionsKey;
+    return key.str();
+}
+
+//! build the key a hlr result is saved with in the document. TShape addresses change when
+//! the document is reloaded, so this hashes the serialized source geometry instead. Only
+//! called when a result is saved or a saved result is first used.
+std::string GeometryObject::makeSavedHlrKey() const
+{
+    if (m_hlrSource.IsNull() || m_hlrOptionsKey.empty()) {
+        return {};
+    }
+
+    // triangulations come and go with the display, they do not change the hlr result
+    std::ostringstream brep;
+#if OCC_VERSION_HEX >= 0x070600
+    BRepTools::Write(m_hlrSource, brep, Standard_False, Standard_False,
+                     TopTools_FormatVersion_CURRENT);
+#else
+    BRepTools::Write(m_hlrSource, brep);
+#endif
+    // FNV-1a, unlike std::hash it is the same on every platform
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char c : brep.str()) {
+        hash = (hash ^ c) * 0x100000001b3ULL;
+    }
+
+    std::ostringstream key;
+    key << std::hex << hash << std::dec << m_hlrOptionsKey;
+    return key.str();
+}
+
+void GeometryObject::addToHlrCache(const std::string& key, const TopoDS_Shape& source,
+                                   const HlrShapes& shapes)
+{
+    if (!key.empty()) {
+        HlrCache::instance().add(key, source, shapes);
+    }
+}
+
+bool GeometryObject::findInHlrCache(const std::string& key, const TopoDS_Shape& source,
+                                    HlrShapes& shapes)
+{
+    return !key.empty() && HlrCache::instance().find(key, source, shapes);
+}
+
+HlrShapes GeometryObject::getHlrShapes() const
+{
+    return {visHard, visOutline, visSmooth, visSeam, visIso,
+            hidHard, hidOutline, hidSmooth, hidSeam, hidIso};
+}
+
+void GeometryObject::setHlrShapes(const HlrShapes& shapes)
+{
+    visHard = shapes[0];
+    visOutline = shapes[1];
+    visSmooth = shapes[2];
+    visSeam = shapes[3];
+    visIso = shapes[4];
+    hidHard = shapes[5];
+    hidOutline = shapes[6];
+    hidSmooth = shapes[7];
+    hidSeam = shapes[8];
+    hidIso = shapes[9];
+}
+
+//! combine hlr results into a single compound for saving. Missing results are stored as
+//! empty compounds to keep the order.
+TopoDS_Shape GeometryObject::packHlrShapes(const HlrShapes& shapes)
+{
+    BRep_Builder builder;
+    TopoDS_Compound result;
+    builder.MakeCompound(result);
+    for (auto& shape : shapes) {
+        if (shape.IsNull()) {
+            TopoDS_Compound empty;
+            builder.MakeCompound(empty);
+            builder.Add(result, empty);
+        }
+        else {
+            builder.Add(result, shape);
+        }
+    }
+    return result;
+}
+
+//! the reverse of packHlrShapes. Returns false if the shape was not made by packHlrShapes.
+bool GeometryObject::unpackHlrShapes(const TopoDS_Shape& packed, HlrShapes& shapes)
+{
+    if (packed.IsNull() || packed.ShapeType() != TopAbs_COMPOUND) {
+        return false;
+    }
+    size_t index = 0;
+    for (TopoDS_Iterator it(packed); it.More(); it.Next()) {
+        if (index >= shapes.size()) {
+            return false;
+        }
+        TopoDS_Iterator content(it.Value());
+        shapes[index++] = content.More() ? it.Value() : TopoDS_Shape();
+    }
+    return index == shapes.size();
+}
+
+//! split a shape into groups of solids, shells and faces whose projections do not overlap.
+//! Shapes in different groups can not hide each other, so the groups can be processed by
+//! independent hlr passes. Returns a single group if the shape is not worth splitting.
+std::vector<TopoDS_Shape> GeometryObject::partitionForHlr(const TopoDS_Shape& inShape,
+                                                          const gp_Ax2& viewAxis) const
+{
+    std::vector<TopoDS_Shape> result{inShape};
+    if (m_isPersp || inShape.IsNull()) {
+        // projected bounds of a perspective view depend on the depth, keep it simple
+        return result;
+    }
+
+    TopTools_IndexedMapOfShape faceMap;
+    TopExp::MapShapes(inShape, TopAbs_FACE, faceMap);
+    int minFaces = Preferences::hlrPartitionFaceCount();
+    if (minFaces <= 0 || faceMap.Extent() < minFaces) {
+        return result;
+    }
+
+    std::vector<TopoDS_Shape> components;
+    for (TopExp_Explorer expl(inShape, TopAbs_SOLID); expl.More(); expl.Next()) {
+        components.push_back(expl.Current());
+    }
+    for (TopExp_Explorer expl(inShape, TopAbs_SHELL, TopAbs_SOLID); expl.More(); expl.Next()) {
+        components.push_back(expl.Current());
+    }
+    for (TopExp_Explorer expl(inShape, TopAbs_FACE, TopAbs_SHELL); expl.More(); expl.Next()) {
+        components.push_back(expl.Current());
+    }
+    for (TopExp_Explorer expl(inShape, TopAbs_EDGE, TopAbs_FACE); expl.More(); expl.Next()) {
+        components.push_back(expl.Current());
+    }
+    if (components.size() < 2) {
+        return result;
+    }
+
+    // extent of each component in the projection plane
+    struct Extent
+    {
+        double uMin, uMax, vMin, vMax;
+    };
+    std::vector<Extent> extents;
+    extents.reserve(components.size());
+    gp_Dir uDir = viewAxis.XDirection();
+    gp_Dir vDir = viewAxis.YDirection();
+    for (auto& component : components) {
+        Bnd_Box box;
+        BRepBndLib::Add(component, box);
+        Extent extent{DBL_MAX, -DBL_MAX, DBL_MAX, -DBL_MAX};
+        if (!box.IsVoid()) {
+            double xMin, yMin, zMin, xMax, yMax, zMax;
+            box.Get(xMin, yMin, zMin, xMax, yMax, zMax);
+            for (int corner = 0; corner < 8; corner++) {
+                gp_Vec pt((corner & 1) ? xMax : xMin,
+                          (corner & 2) ? yMax : yMin,
+                          (corner & 4) ? zMax : zMin);
+                double u = pt.Dot(gp_Vec(uDir));
+                double v = pt.Dot(gp_Vec(vDir));
+                extent.uMin = std::min(extent.uMin, u);
+                extent.uMax = std::max(extent.uMax, u);
+                extent.vMin = std::min(extent.vMin, v);
+                extent.vMax = std::max(extent.vMax, v);
+            }
+        }
+        extents.push_back(extent);
+    }
+
+    // union the components with overlapping extents, sweeping along u
+    std::vector<size_t> parent(components.size());
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](size_t i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+
+    std::vector<size_t> order(components.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&extents](size_t a, size_t b) {
+        return extents[a].uMin < extents[b].uMin;
+    });
+    double tol = Precision::Confusion();
+    std::vector<size_t> active;
+    for (size_t i : order) {
+        const Extent& current = extents[i];
+        active.erase(std::remove_if(active.begin(),
+                                    active.end(),
+                                    [&](size_t j) { return extents[j].uMax < current.uMin - tol; }),
+                     active.end());
+        for (size_t j : active) {
+            if (extents[j].vMin <= current.vMax + tol && current.vMin <= extents[j].vMax + tol) {
+                parent[find(i)] = find(j);
+            }
+        }
+        active.push_back(i);
+    }
+
+    // build a compound per group, keeping the original order of the components
+    std::map<size_t, size_t> groupIndex;
+    std::vector<TopoDS_Compound> compounds;
+    BRep_Builder builder;
+    for (size_t i = 0; i < components.size(); i++) {
+        size_t root = find(i);
+        auto it = groupIndex.find(root);
+        if (it == groupIndex.end()) {
+            it = groupIndex.emplace(root, compounds.size()).first;
+            compounds.emplace_back();
+            builder.MakeCompound(compounds.back());
+        }
+        builder.Add(compounds[it->second], components[i]);
+    }
+    if (compounds.size() < 2) {
+        return result;
+    }
+
+    return {compounds.begin(), compounds.end()};
+}
+
+//! run the exact hlr algorithm on a shape and keep the resulting edge compounds
+void GeometryObject::hideLines(const TopoDS_Shape& inShape, const gp_Ax2& viewAxis)
+{
     Handle(HLRBRep_Algo) brep_hlr;
     try {
         brep_hlr = new HLRBRep_Algo();
@@ -240,8 +728,6 @@ void GeometryObject::projectShape(const TopoDS_Shape& inShape, const gp_Ax2& vie
         throw Base::RuntimeError(
             "GeometryObject::projectShape - unknown error occurred while extracting edges");
     }
-
-    makeTDGeometry();
 }
 
 //convert the hlr output into TD Geometry
@@ -29,6 +29,7 @@
 
 #include <Mod/TechDraw/TechDrawGlobal.h>
 
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
@@ -60,6 +61,10 @@ class Vector;
 class Face;
 class Vertex;
 
+//! the edge compounds of one hlr run, in the order visible hard, outline, smooth, seam, iso
+//! followed by the hidden ones in the same order
+using HlrShapes = std::array<TopoDS_Shape, 10>;
+
 class TechDrawExport GeometryObject
 {
 public:
@@ -99,6 +104,27 @@ public:
     double getFocus() { return m_focus; }
     void setScrubCount(int count) { m_scrubCount = count; }
 
+    //! the shape behind the projected shape, before it was copied, centered and scaled.
+    //! projectShape only uses the hlr cache if this is set. viewKey describes whatever else
+    //! went into the projected shape (scale, rotation).
+    void setHlrSource(const TopoDS_Shape& source, const std::string& viewKey);
+    //! a hlr result saved with the document. projectShape uses it instead of running hlr if
+    //! key matches makeSavedHlrKey.
+    void setSavedHlr(const std::string& key, const HlrShapes& shapes);
+    bool usedSavedHlr() const { return m_usedSavedHlr; }
+    std::string makeSavedHlrKey() const;
+
+    //! key of the last projectShape run in the hlr cache, empty if caching is disabled
+    const std::string& getHlrKey() const { return m_hlrKey; }
+    HlrShapes getHlrShapes() const;
+    void setHlrShapes(const HlrShapes& shapes);
+    static void addToHlrCache(const std::string& key, const TopoDS_Shape& source,
+                              const HlrShapes& shapes);
+    static bool findInHlrCache(const std::string& key, const TopoDS_Shape& source,
+                               HlrShapes& shapes);
+    static TopoDS_Shape packHlrShapes(const HlrShapes& shapes);
+    static bool unpackHlrShapes(const TopoDS_Shape& packed, HlrShapes& shapes);
+
 
     void pruneVertexGeom(Base::Vector3d center, double radius);
 
@@ -141,6 +167,12 @@ protected:
     TopoDS_Shape hidSeam;
     TopoDS_Shape hidIso;
 
+    void runHlr(const TopoDS_Shape& input, const gp_Ax2& viewAxis);
+    void hideLines(const TopoDS_Shape& input, const gp_Ax2& viewAxis);
+    std::string makeHlrOptionsKey(const gp_Ax2& viewAxis) const;
+    std::string makeHlrKey() const;
+    std::vector<TopoDS_Shape> partitionForHlr(const TopoDS_Shape& input,
+                                              const gp_Ax2& viewAxis) const;
     void addGeomFromCompound(TopoDS_Shape edgeCompound, EdgeClass category, bool visible);
     TechDraw::DrawViewDetail* isParentDetail();
 
@@ -165,6 +197,13 @@ protected:
     double m_focus;
     bool m_usePolygonHLR;
     int m_scrubCount;
+    std::string m_hlrKey;
+    std::string m_hlrOptionsKey;
+    std::string m_hlrViewKey;
+    TopoDS_Shape m_hlrSource;
+    std::string m_savedHlrKey;
+    HlrShapes m_savedHlr;
+    bool m_usedSavedHlr = false;
 };
 
 using GeometryObjectPtr = std::shared_ptr<GeometryObject>;
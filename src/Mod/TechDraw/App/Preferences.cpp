@@ -438,6 +438,25 @@ int Preferences::scrubCount()
     return getPreferenceGroup("General")->GetInt("ScrubCount", 1);
 }
 
+//! minimum number of faces before a shape is split into independent hlr passes
+int Preferences::hlrPartitionFaceCount()
+{
+    return getPreferenceGroup("General")->GetInt("HLRPartitionFaceCount", 500);
+}
+
+//! number of faces above which the polygon hlr algorithm is used instead of the exact one.
+//! 0 disables the automatic switch.
+int Preferences::hlrPolygonFaceCount()
+{
+    return getPreferenceGroup("General")->GetInt("HLRPolygonFaceCount", 100000);
+}
+
+//! if true, hlr results are reused for identical shapes and directions and saved with the views
+bool Preferences::cacheHlr()
+{
+    return getPreferenceGroup("General")->GetBool("CacheHLR", true);
+}
+
 //! Returns the factor for the overlap of svg tiles when hatching faces
 double Preferences::svgHatchFactor()
 {
@@ -110,6 +110,9 @@ public:
 
     static bool autoCorrectDimRefs();
     static int scrubCount();
+    static int hlrPartitionFaceCount();
+    static int hlrPolygonFaceCount();
+    static bool cacheHlr();
 
     static double svgHatchFactor();
     static bool SectionUsePreviousCut();
@@ -24,6 +24,7 @@
 
 
 # include <cmath>
+# include <limits>
 # include <sstream>
 # include <Approx_Curve3d.hxx>
 # include <BRep_Tool.hxx>
@@ -159,6 +160,33 @@ SVGOutput::SVGOutput()
 std::string SVGOutput::exportEdges(const TopoDS_Shape& input)
 {
     std::stringstream result;
+    exportEdges(input, result);
+    return result.str();
+}
+
+void SVGOutput::setPrecision(int decimals)
+{
+    m_scale = decimals < 0 ? 0.0 : std::pow(10.0, decimals);
+}
+
+double SVGOutput::quantize(double value) const
+{
+    if (m_scale == 0.0) {
+        return value;
+    }
+    // adding 0.0 turns -0 into 0
+    return std::round(value * m_scale) / m_scale + 0.0;
+}
+
+//! write the edges of input to result as they are visited, without building the whole
+//! document in memory
+void SVGOutput::exportEdges(const TopoDS_Shape& input, std::ostream& result)
+{
+    std::streamsize oldPrecision = result.precision();
+    if (m_scale != 0.0) {
+        // the values are already rounded, so print all significant digits that are left
+        result.precision(std::numeric_limits<double>::digits10);
+    }
 
     TopExp_Explorer edges(input, TopAbs_EDGE);
     for (int i = 1 ; edges.More(); edges.Next(), i++) {
@@ -189,7 +217,7 @@ std::string SVGOutput::exportEdges(const TopoDS_Shape& input)
         }
     }
 
-    return result.str();
+    result.precision(oldPrecision);
 }
 
 void SVGOutput::printCircle(const BRepAdaptor_Curve& c, std::ostream& out)
@@ -210,8 +238,8 @@ void SVGOutput::printCircle(const BRepAdaptor_Curve& c, std::ostream& out)
 
     // a full circle
     if (fabs(l-f) > 1.0 && s.SquareDistance(e) < 0.001) {
-        out << "<circle cx =\"" << p.X() << "\" cy =\""
-            << p.Y() << "\" r =\"" << r << "\" />";
+        out << "<circle cx =\"" << quantize(p.X()) << "\" cy =\""
+            << quantize(p.Y()) << "\" r =\"" << quantize(r) << "\" />";
     }
     // arc of circle
     else {
@@ -219,10 +247,10 @@ void SVGOutput::printCircle(const BRepAdaptor_Curve& c, std::ostream& out)
         char xar = '0'; // x-axis-rotation
         char las = (l-f > std::numbers::pi) ? '1' : '0'; // large-arc-flag
         char swp = (a < 0) ? '1' : '0'; // sweep-flag, i.e. clockwise (0) or counter-clockwise (1)
-        out << "<path d=\"M" << s.X() <<  " " << s.Y()
-            << " A" << r << " " << r << " "
+        out << "<path d=\"M" << quantize(s.X()) <<  " " << quantize(s.Y())
+            << " A" << quantize(r) << " " << quantize(r) << " "
             << xar << " " << las << " " << swp << " "
-            << e.X() << " " << e.Y() << "\" />";
+            << quantize(e.X()) << " " << quantize(e.Y()) << "\" />";
     }
 }
 
@@ -257,19 +285,19 @@ void SVGOutput::printEllipse(const BRepAdaptor_Curve& c, int id, std::ostream& o
     Standard_Real angle = xaxis.AngleWithRef(gp_Dir(1, 0,0), gp_Dir(0, 0,-1));
     angle = Base::toDegrees<double>(angle);
     if (fabs(l-f) > 1.0 && s.SquareDistance(e) < 0.001) {
-        out << "<g transform = \"rotate(" << angle << ", " << p.X() << ", " << p.Y() << ")\">" << std::endl;
-        out << "<ellipse cx =\"" << p.X() << "\" cy =\""
-            << p.Y() << "\" rx =\"" << r1 << "\"  ry =\"" << r2 << "\"/>" << std::endl;
+        out << "<g transform = \"rotate(" << quantize(angle) << ", " << quantize(p.X()) << ", " << quantize(p.Y()) << ")\">" << std::endl;
+        out << "<ellipse cx =\"" << quantize(p.X()) << "\" cy =\""
+            << quantize(p.Y()) << "\" rx =\"" << quantize(r1) << "\"  ry =\"" << quantize(r2) << "\"/>" << std::endl;
         out << "</g>" << std::endl;
     }
     // arc of ellipse
     else {
         char las = (l-f > std::numbers::pi) ? '1' : '0'; // large-arc-flag
         char swp = (a < 0) ? '1' : '0'; // sweep-flag, i.e. clockwise (0) or counter-clockwise (1)
-        out << "<path d=\"M" << s.X() <<  " " << s.Y()
-            << " A" << r1 << " " << r2 << " "
-            << angle << " " << las << " " << swp << " "
-            << e.X() << " " << e.Y() << "\" />" << std::endl;
+        out << "<path d=\"M" << quantize(s.X()) <<  " " << quantize(s.Y())
+            << " A" << quantize(r1) << " " << quantize(r2) << " "
+            << quantize(angle) << " " << las << " " << swp << " "
+            << quantize(e.X()) << " " << quantize(e.Y()) << "\" />" << std::endl;
     }
 }
 
@@ -277,6 +305,7 @@ void SVGOutput::printBezier(const BRepAdaptor_Curve& c, int id, std::ostream& ou
 {
     try {
         std::stringstream str;
+        str.precision(out.precision());
         str << "<path d=\"M";
 
         Handle(Geom_BezierCurve) bezier = c.Bezier();
@@ -298,7 +327,7 @@ void SVGOutput::printBezier(const BRepAdaptor_Curve& c, int id, std::ostream& ou
 
 
         gp_Pnt p1 = bezier->Pole(1);
-        str << p1.X() << ", " << p1.Y();
+        str << quantize(p1.X()) << ", " << quantize(p1.Y());
         if (bezier->Degree() == 3) {
             if (poles != 4)
                 Standard_Failure::Raise("do it the generic way");
@@ -306,9 +335,9 @@ void SVGOutput::printBezier(const BRepAdaptor_Curve& c, int id, std::ostream& ou
             gp_Pnt p3 = bezier->Pole(3);
             gp_Pnt p4 = bezier->Pole(4);
             str << " C"
-                << p2.X() << ", " << p2.Y() << " "
-                << p3.X() << ", " << p3.Y() << " "
-                << p4.X() << ", " << p4.Y() << " ";
+                << quantize(p2.X()) << ", " << quantize(p2.Y()) << " "
+                << quantize(p3.X()) << ", " << quantize(p3.Y()) << " "
+                << quantize(p4.X()) << ", " << quantize(p4.Y()) << " ";
         }
         else if (bezier->Degree() == 2) {
             if (poles != 3)
@@ -316,14 +345,14 @@ void SVGOutput::printBezier(const BRepAdaptor_Curve& c, int id, std::ostream& ou
             gp_Pnt p2 = bezier->Pole(2);
             gp_Pnt p3 = bezier->Pole(3);
             str << " Q"
-                << p2.X() << ", " << p2.Y() << " "
-                << p3.X() << ", " << p3.Y() << " ";
+                << quantize(p2.X()) << ", " << quantize(p2.Y()) << " "
+                << quantize(p3.X()) << ", " << quantize(p3.Y()) << " ";
         }
         else if (bezier->Degree() == 1) {
             if (poles != 2)
                 Standard_Failure::Raise("do it the generic way");
             gp_Pnt p2 = bezier->Pole(2);
-            str << " L" << p2.X() << ", " << p2.Y() << " ";
+            str << " L" << quantize(p2.X()) << ", " << quantize(p2.Y()) << " ";
         }
         else {
             Standard_Failure::Raise("do it the generic way");
@@ -341,6 +370,7 @@ void SVGOutput::printBSpline(const BRepAdaptor_Curve& c, int id, std::ostream& o
 {
     try {
         std::stringstream str;
+        str.precision(out.precision());
         Handle(Geom_BSplineCurve) spline;
         Standard_Real tol3D = 0.001;
         Standard_Integer maxDegree = 3, maxSegment = 100;
@@ -363,7 +393,7 @@ void SVGOutput::printBSpline(const BRepAdaptor_Curve& c, int id, std::ostream& o
             Standard_Integer poles = bezier->NbPoles();
             if (i == 1) {
                 gp_Pnt p1 = bezier->Pole(1);
-                str << p1.X() << ", " << p1.Y();
+                str << quantize(p1.X()) << ", " << quantize(p1.Y());
             }
             if (bezier->Degree() == 3) {
                 if (poles != 4)
@@ -372,9 +402,9 @@ void SVGOutput::printBSpline(const BRepAdaptor_Curve& c, int id, std::ostream& o
                 gp_Pnt p3 = bezier->Pole(3);
                 gp_Pnt p4 = bezier->Pole(4);
                 str << " C"
-                    << p2.X() << ", " << p2.Y() << " "
-                    << p3.X() << ", " << p3.Y() << " "
-                    << p4.X() << ", " << p4.Y() << " ";
+                    << quantize(p2.X()) << ", " << quantize(p2.Y()) << " "
+                    << quantize(p3.X()) << ", " << quantize(p3.Y()) << " "
+                    << quantize(p4.X()) << ", " << quantize(p4.Y()) << " ";
             }
             else if (bezier->Degree() == 2) {
                 if (poles != 3)
@@ -382,14 +412,14 @@ void SVGOutput::printBSpline(const BRepAdaptor_Curve& c, int id, std::ostream& o
                 gp_Pnt p2 = bezier->Pole(2);
                 gp_Pnt p3 = bezier->Pole(3);
                 str << " Q"
-                    << p2.X() << ", " << p2.Y() << " "
-                    << p3.X() << ", " << p3.Y() << " ";
+                    << quantize(p2.X()) << ", " << quantize(p2.Y()) << " "
+                    << quantize(p3.X()) << ", " << quantize(p3.Y()) << " ";
             }
             else if (bezier->Degree() == 1) {
                 if (poles != 2)
                     Standard_Failure::Raise("do it the generic way");
                 gp_Pnt p2 = bezier->Pole(2);
-                str << " L" << p2.X() << ", " << p2.Y() << " ";
+                str << " L" << quantize(p2.X()) << ", " << quantize(p2.Y()) << " ";
             }
             else {
                 Standard_Failure::Raise("do it the generic way");
@@ -413,7 +443,7 @@ void SVGOutput::printGeneric(const BRepAdaptor_Curve& bac, int id, std::ostream&
         char c = 'M';
         out << "<path id= \"" /*<< ViewName*/ << id << "\" d=\" ";
         for (int i = nodes.Lower(); i <= nodes.Upper(); i++){
-            out << c << " " << nodes(i).X() << " " << nodes(i).Y()<< " " ;
+            out << c << " " << quantize(nodes(i).X()) << " " << quantize(nodes(i).Y())<< " " ;
             c = 'L';
         }
         out << "\" />" << endl;
@@ -426,9 +456,9 @@ void SVGOutput::printGeneric(const BRepAdaptor_Curve& bac, int id, std::ostream&
         gp_Pnt e = bac.Value(l);
         char c = 'M';
         out << "<path id= \"" /*<< ViewName*/ << id << "\" d=\" ";
-        out << c << " " << s.X() << " " << s.Y()<< " " ;
+        out << c << " " << quantize(s.X()) << " " << quantize(s.Y())<< " " ;
         c = 'L';
-        out << c << " " << e.X() << " " << e.Y()<< " " ;
+        out << c << " " << quantize(e.X()) << " " << quantize(e.Y())<< " " ;
         out << "\" />" << endl;
     }
 }
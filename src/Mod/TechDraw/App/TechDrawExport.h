@@ -25,6 +25,7 @@
 #ifndef TECHDRAW_EXPORT_H
 #define TECHDRAW_EXPORT_H
 
+#include <iosfwd>
 #include <string>
 #include <TopoDS_Edge.hxx>
 
@@ -51,8 +52,15 @@ class TechDrawExport SVGOutput : public TechDrawOutput
 public:
     SVGOutput();
     std::string exportEdges(const TopoDS_Shape&);
+    void exportEdges(const TopoDS_Shape&, std::ostream&);
+
+    // Round the written coordinates to this many decimals. A negative value writes them unchanged.
+    void setPrecision(int decimals);
 
 private:
+    double quantize(double value) const;
+    double m_scale{0.0};
+
     void printCircle(const BRepAdaptor_Curve&, std::ostream&);
     void printEllipse(const BRepAdaptor_Curve&, int id, std::ostream&);
     void printBSpline(const BRepAdaptor_Curve&, int id, std::ostream&);
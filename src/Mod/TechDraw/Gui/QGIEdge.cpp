@@ -21,8 +21,11 @@
  ***************************************************************************/
 
 
+# include <algorithm>
+# include <QPainter>
 # include <QPainterPath>
 # include <QPainterPathStroker>
+# include <QStyleOptionGraphicsItem>
 
 
 #include <App/Application.h>
@@ -44,7 +47,8 @@ QGIEdge::QGIEdge(int index) :
     projIndex(index),
     isCosmetic(false),
     isHiddenEdge(false),
-    isSmoothEdge(false)
+    isSmoothEdge(false),
+    m_fuzz(getEdgeFuzz())
 {
     setFlag(QGraphicsItem::ItemIsFocusable, true);      // to get key press events
     setFlag(QGraphicsItem::ItemIsSelectable, true);
@@ -94,13 +98,48 @@ QRectF QGIEdge::boundingRect() const
     return shape().controlPointRect();
 }
 
+//! re-read the edge fuzz preference. The cached outline is only rebuilt if it has changed.
+void QGIEdge::updateEdgeFuzz()
+{
+    double fuzz = getEdgeFuzz();
+    if (fuzz != m_fuzz) {
+        prepareGeometryChange();
+        m_fuzz = fuzz;
+        m_shapeSource = QPainterPath();
+        m_shape = QPainterPath();
+    }
+}
+
 QPainterPath QGIEdge::shape() const
 {
-    QPainterPath outline;
-    QPainterPathStroker stroker;
-    stroker.setWidth(getEdgeFuzz());
-    outline = stroker.createStroke(path());
-    return outline;
+    // QPainterPath is implicitly shared, so this is a pointer comparison unless the path was
+    // replaced by setPath
+    QPainterPath current = path();
+    if (m_shape.isEmpty() || m_shapeSource != current) {
+        QPainterPathStroker stroker;
+        stroker.setWidth(m_fuzz);
+        m_shape = stroker.createStroke(current);
+        m_shapeSource = current;
+    }
+    return m_shape;
+}
+
+void QGIEdge::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    // an edge that is smaller than a pixel at the current zoom is drawn as a single segment
+    // instead of stroking the whole curve
+    const QPainterPath edgePath = path();
+    const QRectF extent = edgePath.controlPointRect();
+    const qreal lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    if (std::max(extent.width(), extent.height()) * lod < 1.0 && edgePath.elementCount() > 1) {
+        QPen pen(m_pen);
+        pen.setStyle(Qt::SolidLine);
+        painter->setPen(pen);
+        painter->drawLine(QPointF(edgePath.elementAt(0)),
+                          QPointF(edgePath.elementAt(edgePath.elementCount() - 1)));
+        return;
+    }
+    QGIPrimPath::paint(painter, option, widget);
 }
 
 void QGIEdge::mouseDoubleClickEvent(QGraphicsSceneMouseEvent *event)
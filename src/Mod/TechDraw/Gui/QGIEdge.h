@@ -43,6 +43,7 @@ public:
     int type() const override { return Type;}
     QRectF boundingRect() const override;
     QPainterPath shape() const override;
+    void paint(QPainter * painter, const QStyleOptionGraphicsItem * option, QWidget * widget = nullptr ) override;
 
     int getProjIndex() const { return projIndex; }
 
@@ -54,6 +55,7 @@ public:
     void setPrettyNormal() override;
 
     double getEdgeFuzz() const;
+    void updateEdgeFuzz();
 
     void setLinePen(const QPen& isoPen);
 
@@ -76,6 +78,12 @@ private:
     bool isSmoothEdge;
 
     TechDraw::SourceType m_source{TechDraw::SourceType::GEOMETRY};
+
+    // shape() is called for every hit test and bounding rect query, so the stroked outline is
+    // kept until the path or the fuzz changes
+    double m_fuzz;
+    mutable QPainterPath m_shapeSource;
+    mutable QPainterPath m_shape;
 };
 
 }
@@ -249,7 +249,7 @@ void QGIViewPart::drawViewPart()
         return;
 
     prepareGeometryChange();
-    removePrimitives();//clean the slate
+    removePrimitives(true);//clean the slate, edges are reused by drawAllEdges
     removeDecorations();
 
     if (viewPart->handleFaces() && !viewPart->CoarseView.getValue()) {
@@ -351,6 +351,20 @@ void QGIViewPart::drawAllEdges()
     auto dvp(static_cast<TechDraw::DrawViewPart*>(getViewObject()));
     auto vp = static_cast<ViewProviderViewPart*>(getViewProvider(getViewObject()));
 
+    // reuse the edge items of the previous draw, so an unchanged edge does not have to be
+    // removed from and reinserted into the scene index
+    std::map<int, QGIEdge*> oldItems;
+    for (auto& child : childItems()) {
+        auto* edge = dynamic_cast<QGIEdge*>(child);
+        if (edge) {
+            oldItems[edge->getProjIndex()] = edge;
+        }
+    }
+    MDIViewPage* mdi = getMDIViewPage();
+    if (mdi) {
+        mdi->blockSceneSelection(true);
+    }
+
     const TechDraw::BaseGeomPtrVector& geoms = dvp->getEdgeGeometry();
     TechDraw::BaseGeomPtrVector::const_iterator itGeom = geoms.begin();
     QGIEdge* item;
@@ -360,10 +374,30 @@ void QGIViewPart::drawAllEdges()
             continue;
         }
 
-        item = new QGIEdge(iEdge);
-        addToGroup(item);      //item is created at scene(0, 0), not group(0, 0)
-        item->setPath(drawPainterPath(*itGeom));
+        QPainterPath edgePath = drawPainterPath(*itGeom);
+        auto itOld = oldItems.find(iEdge);
+        if (itOld != oldItems.end()) {
+            item = itOld->second;
+            oldItems.erase(itOld);
+            item->setSelected(false);
+            item->setHiddenEdge(false);
+            item->show();
+            item->updateEdgeFuzz();
+            if (item->path() != edgePath) {
+                item->setPath(edgePath);
+            }
+        }
+        else {
+            item = new QGIEdge(iEdge);
+            addToGroup(item);      //item is created at scene(0, 0), not group(0, 0)
+            item->setPath(edgePath);
+        }
         item->setSource((*itGeom)->source());
+        // a reused item still has the pen of the edge it drew before. Start from a plain
+        // visible line, so edges the formatting below skips (confused cosmetics, missing
+        // tags) do not inherit a stale style.
+        item->setLinePen(m_dashedLineGenerator->getLinePen(1, vp->LineWidth.getValue()));
+        item->setWidth(Rez::guiX(vp->LineWidth.getValue()));
 
         item->setNormalColor(PreferencesGui::getAccessibleQColor(PreferencesGui::normalQColor()));
         if ((*itGeom)->getCosmetic()) {
@@ -431,6 +465,16 @@ void QGIViewPart::drawAllEdges()
         //            edgeId << "QGIVP.edgePath" << i;
         //            dumpPath(edgeId.str().c_str(), edgePath);
     }
+
+    // edges that no longer exist or are not shown
+    for (auto& old : oldItems) {
+        old.second->hide();
+        scene()->removeItem(old.second);
+        delete old.second;
+    }
+    if (mdi) {
+        mdi->blockSceneSelection(false);
+    }
 }
 
 void QGIViewPart::drawAllVertexes()
@@ -620,9 +664,10 @@ QGIFace* QGIViewPart::drawFace(TechDraw::FacePtr f, int idx)
     return gFace;
 }
 
-//! Remove all existing QGIPrimPath items(Vertex, Edge, Face)
+//! Remove all existing QGIPrimPath items(Vertex, Edge, Face). Edges are kept if keepEdges is
+//! set, drawAllEdges will reuse or remove them.
 //note this triggers scene selectionChanged signal if vertex/edge/face is selected
-void QGIViewPart::removePrimitives()
+void QGIViewPart::removePrimitives(bool keepEdges)
 {
     QList<QGraphicsItem*> children = childItems();
     MDIViewPage* mdi = getMDIViewPage();
@@ -631,6 +676,9 @@ void QGIViewPart::removePrimitives()
     }
     for (auto& c : children) {
         QGIPrimPath* prim = dynamic_cast<QGIPrimPath*>(c);
+        if (prim && keepEdges && dynamic_cast<QGIEdge*>(prim)) {
+            continue;
+        }
         if (prim) {
             prim->hide();
             scene()->removeItem(prim);
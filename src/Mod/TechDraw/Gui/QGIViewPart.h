@@ -139,7 +139,7 @@ protected:
     TechDraw::DrawHatch* faceIsHatched(int i, std::vector<TechDraw::DrawHatch*> hatchObjs) const;
     TechDraw::DrawGeomHatch* faceIsGeomHatched(int i, std::vector<TechDraw::DrawGeomHatch*> geomObjs) const;
     void dumpPath(const char* text, QPainterPath path);
-    void removePrimitives();
+    void removePrimitives(bool keepEdges = false);
     void removeDecorations();
     bool prefFaceEdges();
     bool prefPrintCenters();
@@ -5,11 +5,33 @@
 # creates a page and 1 view
 
 
+import os
+import tempfile
 import FreeCAD
+import TechDraw
 import unittest
 from .TechDrawTestUtilities import createPageWithSVGTemplate
 from PySide import QtCore
 
+def waitForThreads():
+    """Runs the event loop for a while, so that the hlr threads can complete"""
+    loop = QtCore.QEventLoop()
+
+    timer = QtCore.QTimer()
+    timer.setSingleShot(True)
+    timer.timeout.connect(loop.quit)
+
+    timer.start(2000)   #2 second delay
+    loop.exec_()
+
+
+def edgeSignature(edges):
+    """Order independent summary of a list of edges"""
+    return sorted((round(e.Length, 6),
+                   round(e.BoundBox.Center.x, 6),
+                   round(e.BoundBox.Center.y, 6)) for e in edges)
+
+
 class DrawViewPartTest(unittest.TestCase):
     def setUp(self):
         """Creates a page"""
@@ -50,5 +72,188 @@ class DrawViewPartTest(unittest.TestCase):
         self.assertEqual(len(edges), 4, "DrawViewPart has wrong number of edges")
         self.assertTrue("Up-to-date" in view.State, "DrawViewPart is not Up-to-date")
 
+    def testWriteSVGPage(self):
+        """Tests if a page can be exported to svg without a gui"""
+        print("testing writeSVGPage")
+        view = FreeCAD.ActiveDocument.addObject("TechDraw::DrawViewPart", "View")
+        self.page.addView(view)
+        FreeCAD.ActiveDocument.View.Source = [FreeCAD.ActiveDocument.Box]
+        FreeCAD.ActiveDocument.recompute()
+        waitForThreads()
+
+        with tempfile.TemporaryDirectory() as tempDir:
+            fileName = os.path.join(tempDir, "page.svg")
+            TechDraw.writeSVGPage(self.page, fileName)
+            with open(fileName, encoding="utf-8") as svgFile:
+                svg = svgFile.read()
+            self.assertTrue(svg.startswith("<?xml"), "svg file has no xml header")
+            self.assertTrue(svg.rstrip().endswith("</svg>"), "svg file is not complete")
+            self.assertEqual(svg.count("<path"), 4, "svg file has wrong number of edges")
+
+            fileNames = [os.path.join(tempDir, "page1.svg"), os.path.join(tempDir, "page2.svg")]
+            TechDraw.writeSVGPages([self.page, self.page], fileNames)
+            for name in fileNames:
+                self.assertTrue(os.path.exists(name), "writeSVGPages did not write all pages")
+
+    def testPartitionedHlr(self):
+        """Tests if splitting the hlr into independent passes gives the same edges as one pass"""
+        print("testing partitioned hlr")
+        doc = FreeCAD.ActiveDocument
+        # two stacked boxes that hide each other and two that stand apart
+        boxes = [doc.Box]
+        for i, base in enumerate([(5, 5, 10), (30, 0, 0), (0, 30, 0)]):
+            box = doc.addObject("Part::Box", "Box%d" % i)
+            box.Placement.Base = FreeCAD.Vector(*base)
+            boxes.append(box)
+        view = doc.addObject("TechDraw::DrawViewPart", "View")
+        self.page.addView(view)
+        view.HardHidden = True
+        view.Source = boxes
+
+        params = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/TechDraw/General")
+        oldCache = params.GetBool("CacheHLR", True)
+        oldCount = params.GetInt("HLRPartitionFaceCount", 500)
+        params.SetBool("CacheHLR", False)
+        try:
+            results = []
+            for count in [0, 1]:
+                params.SetInt("HLRPartitionFaceCount", count)
+                view.touch()
+                doc.recompute()
+                waitForThreads()
+                results.append((edgeSignature(view.getVisibleEdges()),
+                                edgeSignature(view.getHiddenEdges())))
+        finally:
+            params.SetBool("CacheHLR", oldCache)
+            params.SetInt("HLRPartitionFaceCount", oldCount)
+
+        single, partitioned = results
+        self.assertTrue(single[0], "DrawViewPart has no visible edges")
+        self.assertTrue(single[1], "DrawViewPart has no hidden edges")
+        self.assertEqual(partitioned, single, "partitioned hlr does not match a single pass")
+
+    def makeCachedView(self, name):
+        """Adds a view of the box with hidden lines and waits for its projection"""
+        view = FreeCAD.ActiveDocument.addObject("TechDraw::DrawViewPart", name)
+        self.page.addView(view)
+        view.HardHidden = True
+        view.Source = [FreeCAD.ActiveDocument.Box]
+        FreeCAD.ActiveDocument.recompute()
+        waitForThreads()
+        return view
+
+    def viewSignature(self, view):
+        return (edgeSignature(view.getVisibleEdges()), edgeSignature(view.getHiddenEdges()))
+
+    def testHlrCacheHit(self):
+        """Tests if views sharing a cached hlr result get the same edges as a fresh hlr run"""
+        print("testing hlr cache hit")
+        params = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/TechDraw/General")
+        oldCache = params.GetBool("CacheHLR", True)
+        try:
+            params.SetBool("CacheHLR", False)
+            uncached = self.viewSignature(self.makeCachedView("View"))
+
+            params.SetBool("CacheHLR", True)
+            first = self.makeCachedView("View001")
+            second = self.makeCachedView("View002")
+            self.assertTrue(first.HlrCacheKey, "hlr result is not saved")
+            self.assertEqual(second.HlrCacheKey, first.HlrCacheKey)
+            self.assertEqual(self.viewSignature(first), uncached)
+            self.assertEqual(self.viewSignature(second), uncached)
+
+            second.touch()
+            FreeCAD.ActiveDocument.recompute()
+            waitForThreads()
+            self.assertEqual(self.viewSignature(second), uncached)
+        finally:
+            params.SetBool("CacheHLR", oldCache)
+
+    def testHlrCacheInvalidation(self):
+        """Tests if changing the source shape runs the hlr again"""
+        print("testing hlr cache invalidation")
+        params = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/TechDraw/General")
+        oldCache = params.GetBool("CacheHLR", True)
+        params.SetBool("CacheHLR", True)
+        try:
+            view = self.makeCachedView("View")
+            before = self.viewSignature(view)
+            oldKey = view.HlrCacheKey
+
+            FreeCAD.ActiveDocument.Box.Length = 20
+            FreeCAD.ActiveDocument.recompute()
+            waitForThreads()
+            after = self.viewSignature(view)
+            self.assertNotEqual(after, before, "view still shows the old shape")
+            self.assertNotEqual(view.HlrCacheKey, oldKey, "saved hlr result was not replaced")
+            self.assertGreater(max(after[0])[0], max(before[0])[0],
+                               "view edges did not get longer")
+        finally:
+            params.SetBool("CacheHLR", oldCache)
+
+    def testHlrCacheRestore(self):
+        """Tests if the hlr result saved with the document is reused after reopening it"""
+        print("testing hlr cache restore")
+        params = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/TechDraw/General")
+        oldCache = params.GetBool("CacheHLR", True)
+        params.SetBool("CacheHLR", True)
+        try:
+            view = self.makeCachedView("View")
+            self.assertFalse(view.usedSavedHlr())
+            before = self.viewSignature(view)
+            oldKey = view.HlrCacheKey
+            with tempfile.TemporaryDirectory() as tempDir:
+                fileName = os.path.join(tempDir, "TDPart.FCStd")
+                FreeCAD.ActiveDocument.saveAs(fileName)
+                FreeCAD.closeDocument("TDPart")
+                doc = FreeCAD.openDocument(fileName)
+                view = doc.View
+                view.touch()
+                doc.recompute()
+                waitForThreads()
+                self.assertTrue(view.usedSavedHlr(), "saved hlr result was not used")
+                self.assertEqual(view.HlrCacheKey, oldKey)
+                self.assertEqual(self.viewSignature(view), before)
+        finally:
+            params.SetBool("CacheHLR", oldCache)
+
+    def testHlrCacheRestoreChangedGeometry(self):
+        """Tests if the saved hlr result is not used after moving a hole, which keeps the
+        topology and the bounding box of the source"""
+        print("testing hlr cache restore with changed geometry")
+        params = FreeCAD.ParamGet("User parameter:BaseApp/Preferences/Mod/TechDraw/General")
+        oldCache = params.GetBool("CacheHLR", True)
+        params.SetBool("CacheHLR", True)
+        try:
+            doc = FreeCAD.ActiveDocument
+            hole = doc.addObject("Part::Cylinder", "Hole")
+            hole.Radius = 2
+            hole.Height = 10
+            hole.Placement.Base = FreeCAD.Vector(3, 3, 0)
+            cut = doc.addObject("Part::Cut", "Cut")
+            cut.Base = doc.Box
+            cut.Tool = hole
+            view = doc.addObject("TechDraw::DrawViewPart", "View")
+            self.page.addView(view)
+            view.HardHidden = True
+            view.Source = [cut]
+            doc.recompute()
+            waitForThreads()
+            before = self.viewSignature(view)
+            with tempfile.TemporaryDirectory() as tempDir:
+                fileName = os.path.join(tempDir, "TDPart.FCStd")
+                doc.saveAs(fileName)
+                FreeCAD.closeDocument("TDPart")
+                doc = FreeCAD.openDocument(fileName)
+                doc.Hole.Placement.Base = FreeCAD.Vector(6, 6, 0)
+                doc.recompute()
+                waitForThreads()
+                view = doc.View
+                self.assertFalse(view.usedSavedHlr(), "saved hlr result of the old hole was used")
+                self.assertNotEqual(self.viewSignature(view), before,
+                                    "view still shows the old hole")
+        finally:
+            params.SetBool("CacheHLR", oldCache)
+
 if __name__ == "__main__":
     unittest.main()
@@ -553,4 +553,33 @@ TEST_F(ElementMapTest, addAndGetChildElementsTest)
             return e.indexedName.toString() == "Pong2";
         }));
 }
+
+TEST_F(ElementMapTest, findInLargeMap)
+{
+    // Arrange
+    // A map the size of a typical large boolean result
+    const int count = 100000;
+    Data::ElementMap elementMap;
+    for (int i = 1; i <= count; ++i) {
+        Data::IndexedName element("Edge", i);
+        elementMap.setElementName(element, Data::MappedName("E" + std::to_string(i)), 0);
+    }
+
+    // Act
+    int found = 0;
+    for (int i = 1; i <= count; ++i) {
+        if (elementMap.find(Data::MappedName("E" + std::to_string(i))).getIndex() == i) {
+            ++found;
+        }
+    }
+    auto all = elementMap.getAll();
+
+    // Assert
+    EXPECT_EQ(found, count);
+    EXPECT_EQ(elementMap.size(), count);
+    ASSERT_EQ(all.size(), count);
+    EXPECT_TRUE(std::is_sorted(all.begin(), all.end(), [](const auto& a, const auto& b) {
+        return a.name < b.name;
+    }));
+}
 // NOLINTEND(readability-magic-numbers)
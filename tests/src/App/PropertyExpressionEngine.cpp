@@ -8,6 +8,8 @@
 #include "App/Expression.h"
 #include "App/ObjectIdentifier.h"
 #include "App/PropertyExpressionEngine.h"
+#include "App/PropertyLinks.h"
+#include "App/PropertyUnits.h"
 
 #include "src/App/InitApplication.h"
 
@@ -90,4 +92,172 @@ TEST_F(PropertyExpressionEngineTest, executeCrossPropertyReference)
     ;
 }
 
+TEST_F(PropertyExpressionEngineTest, executeAfterRebinding)
+{
+    auto target_path = App::ObjectIdentifier::parse(this_obj(), target_name());
+    std::shared_ptr<App::Expression> first_rule(App::Expression::parse(this_obj(), "2 m"));
+    this_obj()->setExpression(target_path, first_rule);
+    this_obj() -> ExpressionEngine.execute();
+
+    // Changing the binding must not reuse the evaluation order of the previous bindings
+    std::shared_ptr<App::Expression> second_rule(App::Expression::parse(this_obj(), "3 m"));
+    this_obj()->setExpression(target_path, second_rule);
+    this_obj() -> ExpressionEngine.execute();
+
+    auto target_entry = target_prop() -> getPathValue(target_path);
+    ASSERT_TRUE(target_entry.type() == typeid(Base::Quantity));
+    EXPECT_EQ(App::any_cast<Base::Quantity>(target_entry), Base::Quantity::parse("3000 mm"));
+
+    // Removing the binding leaves the last value in place
+    this_obj()->clearExpression(target_path);
+    this_obj() -> ExpressionEngine.execute();
+    target_entry = target_prop() -> getPathValue(target_path);
+    EXPECT_EQ(App::any_cast<Base::Quantity>(target_entry), Base::Quantity::parse("3000 mm"));
+}
+
+TEST_F(PropertyExpressionEngineTest, executeOnlyChangedBindings)
+{
+    auto source_path = App::ObjectIdentifier::parse(this_obj(), source_name());
+    source_prop()->setPathValue(source_path, std::string("1 m"));
+    auto target_path = App::ObjectIdentifier::parse(this_obj(), target_name());
+    std::shared_ptr<App::Expression> target_rule(App::Expression::parse(this_obj(), "parsequant(" + source_name() + ")"));
+    this_obj()->setExpression(target_path, target_rule);
+    this_obj() -> ExpressionEngine.execute();
+
+    // A changed input is picked up
+    source_prop()->setPathValue(source_path, std::string("2 m"));
+    this_obj() -> ExpressionEngine.execute();
+    auto target_entry = target_prop() -> getPathValue(target_path);
+    EXPECT_EQ(App::any_cast<Base::Quantity>(target_entry), Base::Quantity::parse("2000 mm"));
+
+    // Overwriting the bound property restores the expression value
+    target_prop()->setPathValue(target_path, Base::Quantity::parse("5 mm"));
+    this_obj() -> ExpressionEngine.execute();
+    target_entry = target_prop() -> getPathValue(target_path);
+    EXPECT_EQ(App::any_cast<Base::Quantity>(target_entry), Base::Quantity::parse("2000 mm"));
+
+    // Nothing changed, nothing is touched
+    bool touched = false;
+    this_obj() -> ExpressionEngine.execute(App::PropertyExpressionEngine::ExecuteAll, &touched);
+    EXPECT_FALSE(touched);
+
+    // An unrelated binding is not evaluated again. Its input is changed while frozen, which
+    // does not signal the change, so evaluating it again would show the new value.
+    auto other_obj = this_doc() -> addObject("App::VarSet");
+    auto other_value = static_cast<App::PropertyLength*>(other_obj -> addDynamicProperty("App::PropertyLength", "Value"));
+    other_value->setValue(1000.0);
+    auto other_prop = static_cast<App::PropertyLength*>(this_obj() -> addDynamicProperty("App::PropertyLength", "other_length"));
+    auto other_path = App::ObjectIdentifier::parse(this_obj(), "other_length");
+    std::shared_ptr<App::Expression> other_rule(App::Expression::parse(this_obj(), std::string(other_obj->getNameInDocument()) + ".Value"));
+    this_obj()->setExpression(other_path, other_rule);
+    this_obj() -> ExpressionEngine.execute();
+    EXPECT_DOUBLE_EQ(other_prop->getValue(), 1000.0);
+
+    other_obj->freeze();
+    other_value->setValue(4000.0);
+    other_obj->unfreeze();
+    source_prop()->setPathValue(source_path, std::string("3 m"));
+    this_obj() -> ExpressionEngine.execute();
+    target_entry = target_prop() -> getPathValue(target_path);
+    EXPECT_EQ(App::any_cast<Base::Quantity>(target_entry), Base::Quantity::parse("3000 mm"));
+    EXPECT_DOUBLE_EQ(other_prop->getValue(), 1000.0);
+
+    // Every binding is evaluated while a dependency is frozen
+    other_obj->freeze();
+    this_obj() -> ExpressionEngine.execute();
+    EXPECT_DOUBLE_EQ(other_prop->getValue(), 4000.0);
+    other_obj->unfreeze();
+
+    // Deleting a dependency evaluates the binding again, which now fails
+    this_doc()->removeObject(other_obj->getNameInDocument());
+    EXPECT_ANY_THROW(this_obj() -> ExpressionEngine.execute());
+}
+
+TEST_F(PropertyExpressionEngineTest, executeAfterReorderingBindings)
+{
+    this_obj() -> addDynamicProperty("App::PropertyLength", "first_length");
+    this_obj() -> addDynamicProperty("App::PropertyLength", "second_length");
+    auto first_path = App::ObjectIdentifier::parse(this_obj(), "first_length");
+    auto second_path = App::ObjectIdentifier::parse(this_obj(), "second_length");
+    auto bind = [this](const App::ObjectIdentifier& path, const char* text) {
+        std::shared_ptr<App::Expression> rule(App::Expression::parse(this_obj(), text));
+        this_obj()->setExpression(path, rule);
+    };
+    auto value = [this](const char* name) {
+        auto prop = static_cast<App::PropertyLength*>(this_obj() -> getPropertyByName(name));
+        return prop -> getValue();
+    };
+
+    // second_length depends on first_length
+    bind(first_path, "1 m");
+    bind(second_path, "first_length * 5");
+    this_obj() -> ExpressionEngine.execute();
+    EXPECT_DOUBLE_EQ(value("first_length"), 1000.0);
+    EXPECT_DOUBLE_EQ(value("second_length"), 5000.0);
+
+    // Now first_length depends on second_length, so the evaluation order must be reversed;
+    // evaluating in the old order would give first_length = 15 m
+    bind(second_path, "2 m");
+    bind(first_path, "second_length * 3");
+    this_obj() -> ExpressionEngine.execute();
+    EXPECT_DOUBLE_EQ(value("second_length"), 2000.0);
+    EXPECT_DOUBLE_EQ(value("first_length"), 6000.0);
+}
+
+TEST_F(PropertyExpressionEngineTest, executeAfterRelinking)
+{
+    auto first_obj = this_doc() -> addObject("App::VarSet");
+    auto first_value = static_cast<App::PropertyLength*>(first_obj -> addDynamicProperty("App::PropertyLength", "Value"));
+    first_value->setValue(1000.0);
+    auto second_obj = this_doc() -> addObject("App::VarSet");
+    auto second_value = static_cast<App::PropertyLength*>(second_obj -> addDynamicProperty("App::PropertyLength", "Value"));
+    second_value->setValue(2000.0);
+    auto link = static_cast<App::PropertyLink*>(this_obj() -> addDynamicProperty("App::PropertyLink", "source_link"));
+    link->setValue(first_obj);
+
+    auto target_path = App::ObjectIdentifier::parse(this_obj(), target_name());
+    std::shared_ptr<App::Expression> target_rule(App::Expression::parse(this_obj(), "source_link.Value"));
+    this_obj()->setExpression(target_path, target_rule);
+    this_obj() -> ExpressionEngine.execute();
+    auto target_entry = target_prop() -> getPathValue(target_path);
+    EXPECT_EQ(App::any_cast<Base::Quantity>(target_entry), Base::Quantity::parse("1000 mm"));
+
+    // Relinking redirects the dependency without changing the binding
+    link->setValue(second_obj);
+    this_obj() -> ExpressionEngine.execute();
+    target_entry = target_prop() -> getPathValue(target_path);
+    EXPECT_EQ(App::any_cast<Base::Quantity>(target_entry), Base::Quantity::parse("2000 mm"));
+
+    // Changes of the newly linked object are picked up
+    second_value->setValue(3000.0);
+    this_obj() -> ExpressionEngine.execute();
+    target_entry = target_prop() -> getPathValue(target_path);
+    EXPECT_EQ(App::any_cast<Base::Quantity>(target_entry), Base::Quantity::parse("3000 mm"));
+}
+
+TEST_F(PropertyExpressionEngineTest, executeAfterOutputStatusChange)
+{
+    auto input = static_cast<App::PropertyLength*>(this_obj() -> addDynamicProperty("App::PropertyLength", "input_length"));
+    input->setValue(1000.0);
+    auto target_path = App::ObjectIdentifier::parse(this_obj(), target_name());
+    std::shared_ptr<App::Expression> target_rule(App::Expression::parse(this_obj(), "input_length"));
+    this_obj()->setExpression(target_path, target_rule);
+    this_obj() -> ExpressionEngine.execute(App::PropertyExpressionEngine::ExecuteNonOutput);
+    auto target_entry = target_prop() -> getPathValue(target_path);
+    EXPECT_EQ(App::any_cast<Base::Quantity>(target_entry), Base::Quantity::parse("1000 mm"));
+
+    // Output bindings are skipped, even though the cached evaluation order still has the binding
+    target_prop()->setStatus(App::Property::Output, true);
+    input->setValue(2000.0);
+    this_obj() -> ExpressionEngine.execute(App::PropertyExpressionEngine::ExecuteNonOutput);
+    target_entry = target_prop() -> getPathValue(target_path);
+    EXPECT_EQ(App::any_cast<Base::Quantity>(target_entry), Base::Quantity::parse("1000 mm"));
+
+    // And picked up again once the status is cleared
+    target_prop()->setStatus(App::Property::Output, false);
+    this_obj() -> ExpressionEngine.execute(App::PropertyExpressionEngine::ExecuteNonOutput);
+    target_entry = target_prop() -> getPathValue(target_path);
+    EXPECT_EQ(App::any_cast<Base::Quantity>(target_entry), Base::Quantity::parse("2000 mm"));
+}
+
 // clang-format on
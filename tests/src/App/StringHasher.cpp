@@ -9,6 +9,7 @@
 
 #include <QCryptographicHash>
 #include <array>
+#include <thread>
 
 class StringIDTest: public ::testing::Test
 {
@@ -1445,6 +1446,66 @@ TEST_F(StringHasherTest, getIDFromMappedNameDuplicateWithEncodedPostfix)  // NOL
     EXPECT_EQ(secondIDInserted.dataToText(), mappedNameB.toString());
 }
 
+TEST_F(StringHasherTest, getIDsFromByteArrays)  // NOLINT
+{
+    // Arrange
+    std::vector<QByteArray> data {QByteArray("Edge"), QByteArray("Face"), QByteArray("Edge")};
+
+    // Act
+    auto ids = Hasher()->getIDs(data, App::StringHasher::Option::None);
+
+    // Assert
+    ASSERT_EQ(3, ids.size());
+    EXPECT_EQ(ids[0], ids[2]);
+    EXPECT_NE(ids[0], ids[1]);
+    EXPECT_EQ(ids[1], Hasher()->getID(QByteArray("Face"), App::StringHasher::Option::None));
+    EXPECT_EQ(2, Hasher()->size());
+}
+
+TEST_F(StringHasherTest, getIDsFromMappedNames)  // NOLINT
+{
+    // Arrange
+    std::vector<Data::MappedName> names {givenMappedName("Edge1", "postfix"),
+                                         givenMappedName("Edge2", "postfix")};
+
+    // Act
+    auto ids = Hasher()->getIDs(names);
+
+    // Assert
+    ASSERT_EQ(2, ids.size());
+    EXPECT_EQ(1, ids[0].getIndex());
+    EXPECT_EQ(2, ids[1].getIndex());
+    EXPECT_EQ(ids[0].value(), ids[1].value());
+}
+
+TEST_F(StringHasherTest, getIDFromMultipleThreads)  // NOLINT
+{
+    // Arrange
+    const int numThreads {4};
+    const int numStrings {1000};
+    std::vector<std::vector<App::StringIDRef>> ids(numThreads);
+    std::vector<std::thread> threads;
+
+    // Act
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([this, &result = ids[t]]() {
+            for (int i = 0; i < numStrings; ++i) {
+                result.push_back(
+                    Hasher()->getID(QByteArray::number(i), App::StringHasher::Option::None));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Assert
+    EXPECT_EQ(numStrings, Hasher()->size());
+    for (int t = 1; t < numThreads; ++t) {
+        EXPECT_EQ(ids[0], ids[t]);
+    }
+}
+
 TEST_F(StringHasherTest, getIDFromIntegerIDNoSuchID)  // NOLINT
 {
     // Arrange
@@ -5,6 +5,9 @@
 
 #include <memory>
 
+#include <App/Application.h>
+#include <App/Document.h>
+
 #include <Mod/Spreadsheet/App/Sheet.h>
 #include <Mod/Spreadsheet/App/PropertySheet.h>
 
@@ -87,3 +90,79 @@ TEST_F(PropertySheetTest, invalidAliases)  // NOLINT
             << "\"" << name << "\" was accepted as an alias name, and should not be";
     }
 }
+
+class PropertySheetDependencyTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+    void SetUp() override
+    {
+        _docName = App::GetApplication().getUniqueDocumentName("test");
+        _doc = App::GetApplication().newDocument(_docName.c_str(), "testUser");
+        _sheet = freecad_cast<Spreadsheet::Sheet*>(_doc->addObject("Spreadsheet::Sheet", "Sheet"));
+    }
+    void TearDown() override
+    {
+        App::GetApplication().closeDocument(_docName.c_str());
+    }
+
+    Spreadsheet::Sheet* sheet()
+    {
+        return _sheet;
+    }
+
+    /// Names of the cells that reference the cell at \a address
+    std::set<std::string> dependents(const char* address)
+    {
+        std::set<std::string> result;
+        _sheet->providesTo(App::CellAddress(address), result);
+        return result;
+    }
+
+    std::string cellName(const char* address)
+    {
+        return _sheet->getFullName() + "." + address;
+    }
+
+private:
+    std::string _docName;
+    App::Document* _doc {};
+    Spreadsheet::Sheet* _sheet {};
+};
+
+TEST_F(PropertySheetDependencyTest, dependentCellsFollowSetCell)  // NOLINT
+{
+    // Arrange
+    sheet()->setCell("A1", "1");
+    sheet()->setCell("B1", "=A1 + 1");
+    sheet()->setCell("C1", "=B1 * 2");
+
+    // Act
+    auto dependentsA1 = dependents("A1");
+    auto dependentsB1 = dependents("B1");
+    sheet()->setCell("C1", "=A1 * 2");
+    auto dependentsA1After = dependents("A1");
+    auto dependentsB1After = dependents("B1");
+
+    // Assert
+    EXPECT_EQ(dependentsA1, std::set<std::string> {cellName("B1")});
+    EXPECT_EQ(dependentsB1, std::set<std::string> {cellName("C1")});
+    EXPECT_EQ(dependentsA1After, (std::set<std::string> {cellName("B1"), cellName("C1")}));
+    EXPECT_TRUE(dependentsB1After.empty());
+}
+
+TEST_F(PropertySheetDependencyTest, dependentCellsThroughAlias)  // NOLINT
+{
+    // Arrange
+    sheet()->setCell("A1", "1");
+    sheet()->setAlias(App::CellAddress("A1"), "length");
+
+    // Act
+    sheet()->setCell("B1", "=length * 2");
+
+    // Assert
+    EXPECT_EQ(dependents("A1"), std::set<std::string> {cellName("B1")});
+}